@@ -0,0 +1,44 @@
+#!/bin/sh
+# Decoding benchmark: decodes each stream with every combination of thread
+# count and SIMD level and appends one JSON line per run to the report.
+#
+# usage: ./bench.sh [-t "1 2 4 8"] [-c "0 1 2"] [-r N] [-o report.json] stream.avs...
+#   -t  thread counts (default: "1 2 4 8")
+#   -c  SIMD levels, 0: auto, 1: without AVX, 2: C only (default: "0 1 2")
+#   -r  repetitions of each run (default: 1)
+#   -o  report file (default: bench.json)
+
+threads="1 2 4 8"
+cpus="0 1 2"
+repeat=1
+report=bench.json
+davs2=${DAVS2:-./davs2}
+
+while getopts "t:c:r:o:" opt; do
+    case $opt in
+        t) threads=$OPTARG ;;
+        c) cpus=$OPTARG ;;
+        r) repeat=$OPTARG ;;
+        o) report=$OPTARG ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -eq 0 ]; then
+    echo "usage: $0 [-t threads] [-c cpus] [-r repeat] [-o report.json] stream.avs..."
+    exit 1
+fi
+
+for stream in "$@"; do
+    for t in $threads; do
+        for c in $cpus; do
+            i=0
+            while [ $i -lt $repeat ]; do
+                echo "$stream: threads $t, cpu $c"
+                "$davs2" -i "$stream" -t $t -c $c -b "$report" > /dev/null 2>&1 || echo "  failed"
+                i=$((i + 1))
+            done
+        done
+    done
+done
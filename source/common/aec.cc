@@ -290,20 +290,16 @@ void update_ctx_lps(context_t *ctx)
 
 #if CTRL_OPT_AEC
 /* ---------------------------------------------------------------------------
+ * init the context transition tables, called once per process (davs2_decoder_open)
  */
 void init_aec_context_tab(void)
 {
-    static bool_t b_inited = 0;
     context_t ctx_i;
     context_t ctx_o;
     int cycno;
     int mps;
 
-    if (b_inited != 0) {
-        return;
-    }
     /* init context table */
-    b_inited = 1;
     ctx_i.v = 0;
     ctx_o.v = 0;
     memset(g_tab_ctx_mps, 0, sizeof(g_tab_ctx_mps));
@@ -348,6 +344,12 @@ void init_aec_context_tab(void)
         }
     }
 }
+#else
+/* ---------------------------------------------------------------------------
+ */
+void init_aec_context_tab(void)
+{
+}
 #endif
 
 /* ---------------------------------------------------------------------------
@@ -355,9 +357,6 @@ void init_aec_context_tab(void)
  */
 int aec_start_decoding(aec_t *p_aec, uint8_t *p_start, int i_byte_pos, int i_bytes)
 {
-#if CTRL_OPT_AEC
-    init_aec_context_tab();
-#endif
     p_aec->p_buffer         = p_start;
     p_aec->i_byte_pos       = i_byte_pos;
     p_aec->i_bytes          = i_bytes;
@@ -1855,83 +1854,39 @@ int get_abssum_of_n_last_coeffs(runlevel_pair_t *p_runlevel, int end_pair_pos, i
 }
 
 /* ---------------------------------------------------------------------------
+ * context derivation classes of the run parser
  */
-typedef int (*aec_read_run_f)(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_cg, int b_1st_cg);
-
-/* ---------------------------------------------------------------------------
- */
-static
-int aec_read_run_luma1(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_cg, int b_1st_cg)
-{
-    int ctxpos;
-    int Run = 0;
-    int offset = 0;
-
-    b_only_one_cg = b_only_one_cg ? 0 : 4;
-
-    for (ctxpos = 0; Run != pos; ctxpos++) {
-        if (ctxpos < pos) {
-            int moddiv; // 012
-            moddiv = (tab_scan_4x4[pos - 1 - ctxpos][1] + 1) >> 1;
-            offset = (b_1st_cg ? (pos == ctxpos + 1 ? 0 : (1 + moddiv)) : (4 + moddiv)) + b_only_one_cg;  // 0,...,10
-        }
-
-        assert(offset >= 0 && offset < NUM_MAP_CTX);
-        if (biari_decode_symbol(p_aec, p_ctx + offset)) {
-            break;
-        }
-
-        Run++;
-    }
-
-    return Run;
-}
-
-/* ---------------------------------------------------------------------------
- */
-static
-int aec_read_run_luma2(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_cg, int b_1st_cg)
-{
-    int ctxpos;
-    int Run = 0;
-    int offset = 0;
-
-    b_only_one_cg = b_only_one_cg ? 0 : 4;
-    
-    for (ctxpos = 0; Run != pos; ctxpos++) {
-        if (ctxpos < pos) {
-            int moddiv; // 012
-            moddiv = ((pos < ctxpos + 4) ? 0 : (pos < ctxpos + 11 ? 1 : 2));
-            offset = (b_1st_cg ? (pos == ctxpos + 1 ? 0 : (1 + moddiv)) : (4 + moddiv)) + b_only_one_cg;  // 0,...,10
-        }
-
-        assert(offset >= 0 && offset < NUM_MAP_CTX);
-        if (biari_decode_symbol(p_aec, p_ctx + offset)) {
-            break;
-        }
-
-        Run++;
-    }
-
-    return Run;
-}
-
+enum coeff_run_type_e {
+    RUN_LUMA      = 0,    /* luma block, non DC/DIAG intra prediction class */
+    RUN_LUMA_DIAG = 1,    /* luma block, DC/DIAG intra prediction class (and inter) */
+    RUN_CHROMA    = 2     /* chroma block */
+};
 
 /* ---------------------------------------------------------------------------
+ * run_type is a compile-time constant in all callers, so that each variant is
+ * expanded without any branch on the block type inside the bin loop
  */
-static
-int aec_read_run_chroma(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_cg, int b_1st_cg)
+static ALWAYS_INLINE
+int aec_read_run(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_cg, int b_1st_cg, const int run_type)
 {
+    const int ctx_ac = (run_type == RUN_CHROMA) ? 3 : 4;
     int ctxpos;
     int Run = 0;
     int offset = 0;
 
-    b_only_one_cg = b_only_one_cg ? 0 : 3;
+    b_only_one_cg = b_only_one_cg ? 0 : ctx_ac;
 
     for (ctxpos = 0; Run != pos; ctxpos++) {
         if (ctxpos < pos) {
-            int moddiv = (pos >= 6 + ctxpos);
-            offset = (b_1st_cg ? (pos == ctxpos + 1 ? 0 : (1 + moddiv)) : (3 + moddiv)) + b_only_one_cg;
+            int moddiv; // 0, 1, 2
+            if (run_type == RUN_LUMA) {
+                moddiv = (tab_scan_4x4[pos - 1 - ctxpos][1] + 1) >> 1;
+            } else if (run_type == RUN_LUMA_DIAG) {
+                moddiv = ((pos < ctxpos + 4) ? 0 : (pos < ctxpos + 11 ? 1 : 2));
+            } else {
+                moddiv = (pos >= 6 + ctxpos);
+            }
+            offset = (b_1st_cg ? (pos == ctxpos + 1 ? 0 : (1 + moddiv)) : (ctx_ac + moddiv)) + b_only_one_cg;  // 0,...,10
         }
 
         assert(offset >= 0 && offset < NUM_MAP_CTX);
@@ -1947,10 +1902,13 @@ int aec_read_run_chroma(aec_t *p_aec, context_t *p_ctx, int pos, int b_only_one_
 
 
 /* ---------------------------------------------------------------------------
+ * parse run/level pairs of all CGs in one block and write the scaled levels
+ * directly into the coefficient buffer. b_luma, is_dc_diag and b_only_one_cg
+ * are constants in each specialized caller below
  */
-static
-int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_dc_diag,
-                       runlevel_t *runlevel, int scale, int shift)
+static ALWAYS_INLINE
+int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, const int b_luma, const int is_dc_diag,
+                       const int b_only_one_cg, runlevel_t *runlevel, int scale, int shift)
 {
     static const int numOfCoeffInCG = 16;
     const int add = (1 << (shift - 1));
@@ -1967,8 +1925,10 @@ int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_
     int cg_pos = 0;
     int CGx = 0;
     int CGy = 0;
-    int b_only_one_cg = (num_cg == 1);
+    int max_x = 0;
+    int max_y = 0;
     int8_t dct_pattern = DCT_QUAD;
+    const int run_type = b_luma ? (is_dc_diag ? RUN_LUMA_DIAG : RUN_LUMA) : RUN_CHROMA;
     int w_tr_half, w_tr_quad; // CG position limitation
     int h_tr_half, h_tr_quad; // CG position limitation
     int w_tr = runlevel->w_tr;
@@ -1977,7 +1937,6 @@ int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_
     int idx_runlevel = 0;
 #endif
     int rank = 0;
-    aec_read_run_f f_read_run = b_luma ? (!is_dc_diag ? aec_read_run_luma1 : aec_read_run_luma2) : aec_read_run_chroma;
 
     /* dct_pattern_e */
     if (w_tr == h_tr) {
@@ -2003,7 +1962,7 @@ int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_
     h_tr_quad >>= 2;
 
     /* 1, read last CG position */
-    if (num_cg > 1) {
+    if (!b_only_one_cg) {
         int num_cg_x_minus1 = tab_cg_scan[num_cg - 1][0];
         int num_cg_y_minus1 = tab_cg_scan[num_cg - 1][1];
         cg_pos = aec_read_last_cg_pos(p_aec, p_ctx_last_cg_pos, p_cu, &CGx, &CGy, b_luma, num_cg, is_dc_diag, num_cg_x_minus1, num_cg_y_minus1);
@@ -2080,7 +2039,7 @@ int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_
                 // run
                 Run = 0;
                 if (pos > 0) {
-                    Run = f_read_run(p_aec, p_ctx, pos, b_only_one_cg, b_1st_cg);
+                    Run = aec_read_run(p_aec, p_ctx, pos, b_only_one_cg, b_1st_cg, run_type);
                 }
                 AEC_RETURN_ON_ERROR(-1);
 
@@ -2144,21 +2103,45 @@ int aec_read_run_level(aec_t *p_aec, cu_t *p_cu, int num_cg, int b_luma, int is_
 
                     level = (level * scale + add) >> shift;
                     p_res[y_in_cg * i_coeff + x_in_cg] = (coeff_t)DAVS2_CLIP3(-32768, 32767, level);
-                }
-
-                if (CGy >= h_tr_half || CGx >= w_tr_half) {
-                    dct_pattern = DCT_DEAULT;
-                } else if ((CGy >= h_tr_quad || CGx >= w_tr_quad) && dct_pattern != DCT_DEAULT) {
-                    dct_pattern = DCT_HALF;
+                    max_x = DAVS2_MAX(max_x, (CGx << 2) + x_in_cg);
+                    max_y = DAVS2_MAX(max_y, (CGy << 2) + y_in_cg);
                 }
             }
         }  // end of reading one CG
         cg_pos--;
     }  // end of reading all CGs
 
+    runlevel->max_x = max_x;
+    runlevel->max_y = max_y;
+
+    /* select partial inverse transform from the bounding box of non-zero coefficients */
+    if (max_x == 0 && max_y == 0) {
+        dct_pattern = DCT_DC;
+    } else if ((max_y >> 2) >= h_tr_half || (max_x >> 2) >= w_tr_half) {
+        dct_pattern = DCT_DEAULT;
+    } else if ((max_y >> 2) >= h_tr_quad || (max_x >> 2) >= w_tr_quad) {
+        dct_pattern = DCT_HALF;
+    }
+
     return dct_pattern;
 }
 
+#define DECLARE_READ_RUN_LEVEL(name, b_luma, is_dc_diag, b_only_one_cg) \
+static \
+int name(aec_t *p_aec, cu_t *p_cu, int num_cg, runlevel_t *runlevel, int scale, int shift) \
+{\
+    return aec_read_run_level(p_aec, p_cu, num_cg, b_luma, is_dc_diag, b_only_one_cg, runlevel, scale, shift);\
+}
+
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_luma_4x4,        1, 0, 1)
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_luma,            1, 0, 0)
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_luma_diag_4x4,   1, 1, 1)
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_luma_diag,       1, 1, 0)
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_chroma_4x4,      0, 1, 1)
+DECLARE_READ_RUN_LEVEL(aec_read_run_level_chroma,          0, 1, 0)
+
+#undef DECLARE_READ_RUN_LEVEL
+
 /* ---------------------------------------------------------------------------
  * get coefficients of one block
  */
@@ -2179,7 +2162,16 @@ int8_t cu_get_block_coeffs(aec_t *p_aec, runlevel_t *runlevel,
     runlevel->h_tr          = h_tr;
     UNUSED_PARAMETER(wq_size_id);
 
-    return (int8_t)aec_read_run_level(p_aec, p_cu, num_cg, b_luma, intra_pred_class == INTRA_PRED_DC_DIAG, runlevel, scale, shift);
+    if (!b_luma) {
+        return (int8_t)(num_cg == 1 ? aec_read_run_level_chroma_4x4(p_aec, p_cu, num_cg, runlevel, scale, shift)
+                                    : aec_read_run_level_chroma    (p_aec, p_cu, num_cg, runlevel, scale, shift));
+    } else if (intra_pred_class == INTRA_PRED_DC_DIAG) {
+        return (int8_t)(num_cg == 1 ? aec_read_run_level_luma_diag_4x4(p_aec, p_cu, num_cg, runlevel, scale, shift)
+                                    : aec_read_run_level_luma_diag    (p_aec, p_cu, num_cg, runlevel, scale, shift));
+    } else {
+        return (int8_t)(num_cg == 1 ? aec_read_run_level_luma_4x4(p_aec, p_cu, num_cg, runlevel, scale, shift)
+                                    : aec_read_run_level_luma    (p_aec, p_cu, num_cg, runlevel, scale, shift));
+    }
 }
 
 /* ---------------------------------------------------------------------------
@@ -46,6 +46,8 @@ extern const int        tab_intra_mode_scan_type[NUM_INTRA_MODE];
 
 /* ---------------------------------------------------------------------------
  * aec basic operations */
+#define init_aec_context_tab FPFX(init_aec_context_tab)
+void init_aec_context_tab   (void);
 #define aec_init_contexts FPFX(aec_init_contexts)
 void aec_init_contexts      (aec_t *p_aec);
 #define aec_new_slice FPFX(aec_new_slice)
@@ -313,12 +313,9 @@ static void alf_param_init(alf_param_t *alf_par, int cID)
 
 /* ---------------------------------------------------------------------------
  */
-size_t alf_get_buffer_size(davs2_t *h)
+size_t alf_get_buffer_size(int width_in_lcu, int height_in_lcu)
 {
-    size_t width_in_lcu  = h->i_width_in_lcu;
-    size_t height_in_lcu = h->i_height_in_lcu;
-
-    return  sizeof(alf_var_t) + height_in_lcu * width_in_lcu * sizeof(uint8_t);
+    return  sizeof(alf_var_t) + (size_t)height_in_lcu * width_in_lcu * sizeof(uint8_t);
 }
 
 /* ---------------------------------------------------------------------------
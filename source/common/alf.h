@@ -37,7 +37,7 @@ extern "C" {
 #endif
 
 #define alf_get_buffer_size FPFX(alf_get_buffer_size)
-size_t alf_get_buffer_size(davs2_t *h);
+size_t alf_get_buffer_size(int width_in_lcu, int height_in_lcu);
 #define alf_init_buffer FPFX(alf_init_buffer)
 void alf_init_buffer    (davs2_t *h);
 
@@ -49,7 +49,7 @@
 /* ---------------------------------------------------------------------------
  */
 static ALWAYS_INLINE 
-cu_t *get_neighbor_cu_in_slice(davs2_t *h, cu_t *p_cur, int scu_x, int scu_y, int x4x4, int y4x4)
+const scu_t *get_neighbor_cu_in_slice(davs2_t *h, const scu_t *p_cur, int scu_x, int scu_y, int x4x4, int y4x4)
 {
     const int shift_4x4 = MIN_CU_SIZE_IN_BIT - MIN_PU_SIZE_IN_BIT;
 
@@ -58,7 +58,7 @@ cu_t *get_neighbor_cu_in_slice(davs2_t *h, cu_t *p_cur, int scu_x, int scu_y, in
     } else if ((scu_x << shift_4x4) <= x4x4 && (scu_y << shift_4x4) <= y4x4) {
         return p_cur;
     } else {
-        cu_t *p_neighbor = &h->scu_data[(y4x4 >> 1) * h->i_width_in_scu + (x4x4 >> 1)];
+        const scu_t *p_neighbor = &h->scu_data[(y4x4 >> 1) * h->i_width_in_scu + (x4x4 >> 1)];
         return p_neighbor->i_slice_nr == p_cur->i_slice_nr ? p_neighbor : NULL;
     }
 }
@@ -69,7 +69,11 @@ cu_t *get_neighbor_cu_in_slice(davs2_t *h, cu_t *p_cur, int scu_x, int scu_y, in
  */
 int get_neighbor_cbp_y(davs2_t *h, int x_4x4, int y_4x4, int scu_x, int scu_y, cu_t *p_cu)
 {
-    cu_t *p_neighbor = get_neighbor_cu_in_slice(h, p_cu, scu_x, scu_y, x_4x4, y_4x4);
+    const scu_t *p_neighbor;
+    scu_t cur_scu;
+
+    cu_get_scu(&cur_scu, p_cu);
+    p_neighbor = get_neighbor_cu_in_slice(h, &cur_scu, scu_x, scu_y, x_4x4, y_4x4);
 
     if (p_neighbor == NULL) {
         return 0;
@@ -42,4 +42,19 @@ int  get_neighbor_cbp_y(davs2_t *h, int xN, int yN, int scu_x, int scu_y, cu_t *
 #ifdef __cplusplus
 }
 #endif
+
+/* ---------------------------------------------------------------------------
+ * extract the neighboring info (stored per SCU) of a CU
+ */
+static ALWAYS_INLINE void cu_get_scu(scu_t *p_scu, const cu_t *p_cu)
+{
+    p_scu->i_cu_level   = p_cu->i_cu_level;
+    p_scu->i_cu_type    = p_cu->i_cu_type;
+    p_scu->i_slice_nr   = p_cu->i_slice_nr;
+    p_scu->i_qp         = p_cu->i_qp;
+    p_scu->i_cbp        = p_cu->i_cbp;
+    p_scu->i_trans_size = p_cu->i_trans_size;
+    p_scu->c_ipred_mode = p_cu->c_ipred_mode;
+    p_scu->reserved     = 0;
+}
 #endif // DAVS2_BLOCK_INFO_H
@@ -32,6 +32,13 @@
 
 #include "common.h"
 #include <stdarg.h>
+#if HAVE_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if SYS_LINUX
+#include <sys/syscall.h>
+#endif
 
 #if __ARM_ARCH_7__
 #include <android/log.h>
@@ -43,7 +50,10 @@
  * macros
  * ===========================================================================
  */
-
+#if SYS_LINUX && defined(SYS_mbind)
+#define MEM_MPOL_PREFERRED      1       /* MPOL_PREFERRED of <numaif.h>, libnuma is not required */
+#define MEM_MAX_NUMA_NODES      1024    /* number of bits in the node mask passed to mbind() */
+#endif
 
 /**
  * ===========================================================================
@@ -343,6 +353,183 @@ void *xl_remove_head_ex(xlist_t *const xlist)
     return node;
 }
 
+/**
+ * ===========================================================================
+ * memory accounting
+ * ===========================================================================
+ */
+
+/* ---------------------------------------------------------------------------
+ * account an allocation of the given category. with b_enforce set, nothing
+ * is charged and -1 is returned if the allocation would exceed the budget
+ */
+int davs2_mem_charge(davs2_mgr_t *mgr, int type, size_t size, int b_enforce)
+{
+    int64_t budget = mgr->param.max_memory;
+    int64_t total  = 0;
+    int ret = 0;
+    int i;
+
+    assert(type >= 0 && type < MEM_TYPE_NUM);
+
+    davs2_thread_mutex_lock(&mgr->mutex_mem);
+
+    for (i = 0; i < MEM_TYPE_NUM; i++) {
+        total += mgr->mem_used[i];
+    }
+
+    if (b_enforce && budget > 0 && total + (int64_t)size > budget) {
+        ret = -1;
+    } else {
+        mgr->mem_used[type] += (int64_t)size;
+    }
+
+    davs2_thread_mutex_unlock(&mgr->mutex_mem);
+
+    return ret;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+void davs2_mem_release(davs2_mgr_t *mgr, int type, size_t size)
+{
+    assert(type >= 0 && type < MEM_TYPE_NUM);
+
+    davs2_thread_mutex_lock(&mgr->mutex_mem);
+    mgr->mem_used[type] -= (int64_t)size;
+    assert(mgr->mem_used[type] >= 0);
+    davs2_thread_mutex_unlock(&mgr->mutex_mem);
+}
+
+/**
+ * ===========================================================================
+ * memory placement
+ * ===========================================================================
+ */
+
+#if HAVE_MMAP
+/* ---------------------------------------------------------------------------
+ * prefer the physical pages of a mapping (not touched yet) on a NUMA node
+ */
+static void mem_bind_numa_node(void *ptr, size_t size, int node)
+{
+#if SYS_LINUX && defined(SYS_mbind)
+    const int bits = 8 * sizeof(unsigned long);
+    unsigned long nodemask[MEM_MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+
+    if (node < 0 || node >= MEM_MAX_NUMA_NODES - 1) {
+        return;
+    }
+
+    memset(nodemask, 0, sizeof(nodemask));
+    nodemask[node / bits] |= 1UL << (node % bits);
+    if (syscall(SYS_mbind, ptr, size, MEM_MPOL_PREFERRED, nodemask, MEM_MAX_NUMA_NODES, 0) != 0) {
+        davs2_log(NULL, DAVS2_LOG_WARNING, "failed to bind memory to NUMA node %d\n", node);
+    }
+#else
+    UNUSED_PARAMETER(ptr);
+    UNUSED_PARAMETER(size);
+    UNUSED_PARAMETER(node);
+#endif
+}
+
+/* ---------------------------------------------------------------------------
+ * map anonymous memory aligned to the page size
+ */
+static uint8_t *mem_map_pages(size_t map_size, size_t page_size)
+{
+    uint8_t *buf = (uint8_t *)mmap(NULL, map_size + page_size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    uint8_t *align_buf;
+
+    if ((void *)buf == MAP_FAILED) {
+        return NULL;
+    }
+
+    /* trim the unaligned head and the tail */
+    align_buf = (uint8_t *)(((intptr_t)buf + page_size - 1) & ~((intptr_t)page_size - 1));
+    if (align_buf > buf) {
+        munmap(buf, align_buf - buf);
+    }
+    if (align_buf + map_size < buf + map_size + page_size) {
+        munmap(align_buf + map_size, (buf + map_size + page_size) - (align_buf + map_size));
+    }
+
+    return align_buf;
+}
+#endif
+
+/* ---------------------------------------------------------------------------
+ * allocate a large buffer. the buffer is mapped directly from the system when
+ * huge pages or a NUMA node are requested, so that the placement policy only
+ * applies to it (a plain aligned malloc is used otherwise). the size of the
+ * mapping is stored in a header of CACHE_LINE_SIZE bytes before the buffer
+ */
+void *davs2_malloc_pages(size_t i_size, int b_huge_pages, int i_numa_node)
+{
+    uint8_t *buf = NULL;
+
+#if HAVE_MMAP
+    if (b_huge_pages || i_numa_node >= 0) {
+        size_t page_size = b_huge_pages ? HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+        size_t map_size  = (i_size + CACHE_LINE_SIZE + page_size - 1) & ~(page_size - 1);
+
+#if defined(MAP_HUGETLB)
+        if (b_huge_pages) {
+            /* explicit huge pages, available if reserved in the hugetlbfs pool */
+            buf = (uint8_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if ((void *)buf == MAP_FAILED) {
+                buf = NULL;
+            }
+        }
+#endif
+        if (buf == NULL && (buf = mem_map_pages(map_size, page_size)) != NULL) {
+#if HAVE_THP
+            if (b_huge_pages) {
+                madvise(buf, map_size, MADV_HUGEPAGE);  /* transparent huge pages */
+            }
+#endif
+        }
+
+        if (buf != NULL) {
+            mem_bind_numa_node(buf, map_size, i_numa_node);
+            *(size_t *)buf = map_size;
+            return buf + CACHE_LINE_SIZE;
+        }
+    }
+#else
+    UNUSED_PARAMETER(b_huge_pages);
+    UNUSED_PARAMETER(i_numa_node);
+#endif
+
+    buf = (uint8_t *)davs2_malloc(i_size + CACHE_LINE_SIZE);
+    if (buf != NULL) {
+        *(size_t *)buf = 0;     /* not mapped */
+        buf += CACHE_LINE_SIZE;
+    }
+
+    return buf;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+void davs2_free_pages(void *ptr)
+{
+    if (ptr != NULL) {
+        uint8_t *buf = (uint8_t *)ptr - CACHE_LINE_SIZE;
+
+#if HAVE_MMAP
+        size_t map_size = *(size_t *)buf;
+        if (map_size != 0) {
+            munmap(buf, map_size);
+            return;
+        }
+#endif
+        davs2_free(buf);
+    }
+}
+
 /**
  * ===========================================================================
  * davs2_log
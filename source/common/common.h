@@ -73,10 +73,12 @@ typedef int16_t                 coeff_t;    /* type for transform coefficient */
 typedef int16_t                 mct_t;       /* motion compensation temp*/
 typedef uint8_t                 bool_t;     /* type for flag */
 
+typedef struct scu_t            scu_t;
 typedef struct cu_t             cu_t;
 typedef struct davs2_log_t      davs2_log_t;
 typedef struct davs2_t          davs2_t;
 typedef struct davs2_mgr_t      davs2_mgr_t;
+typedef struct davs2_group_t    davs2_group_t;
 typedef struct davs2_outpic_t   davs2_outpic_t;
 
 
@@ -166,6 +168,17 @@ enum task_status_t {
     TASK_BUSY    = 1            /* task busy */
 };
 
+/* ---------------------------------------------------------------------------
+ * categories of allocated memory (see davs2_memory_info_t) */
+enum mem_type_e {
+    MEM_CONTEXT      = 0,       /* decoder handle and frame decoder contexts */
+    MEM_FRAMES       = 1,       /* DPB frames */
+    MEM_TASK_BUFFERS = 2,       /* per-task extra buffers */
+    MEM_BITSTREAM    = 3,       /* input ES units */
+    MEM_OUTPUT       = 4,       /* output pictures */
+    MEM_TYPE_NUM     = 5
+};
+
 /* ---------------------------------------------------------------------------
  * coding types */
 enum coding_type_e {
@@ -279,6 +292,7 @@ enum dct_pattern_e {
     DCT_DEAULT,      /* default */
     DCT_HALF,        /* οϽ1/2ߣ1/4 ǷοΪϽ1/21/2 */
     DCT_QUAD,        /* οϽ1/4ߣ1/16ǷοΪϽ1/41/4 */
+    DCT_DC,          /* only the DC coefficient is non-zero */
     /* max number of DCT pattern */
     DCT_PATTERN_NUM
 };
@@ -699,6 +713,7 @@ typedef struct davs2_frame_t {
     int         i_chroma_format;      /* chroma format    (for function davs2_write_a_frame) */
     int         i_output_bit_depth;   /* output bit depth (for function davs2_write_a_frame) */
     int         i_sample_bit_depth;   /* sample bit depth (for function davs2_write_a_frame) */
+    int         i_output_scale;       /* output downscaling, 0: none, 1: 1/2, 2: 1/4 (for function davs2_write_a_frame) */
     int         frm_decode_error;     /* is there any decoding error in this frame? */
 
     int         dist_refs[AVS2_MAX_REFS];  /* distance of reference frames, used for MV scaling */
@@ -721,6 +736,9 @@ typedef struct davs2_frame_t {
     /* frames with 'i_disposable' greater than 0 should NOT be referenced. */
 
     int          is_self_malloc;      /* is the buffer allocated by itself */
+    size_t       i_mem_size;          /* size of the buffer allocated by itself (0 if not self malloced) */
+    int          b_huge_pages;        /* the buffer allocated by itself is backed by huge pages */
+    int          i_numa_node;         /* NUMA node the buffer allocated by itself is bound to, -1: none */
     volatile int i_decoded_line;      /* latest lcu line that finished reconstruction */
     volatile int i_parsed_lcu_xy;     /* parsed number of LCU */
     int          i_conds;             /* number conds */
@@ -782,6 +800,8 @@ typedef struct runlevel_t {
     int            i_tu_level;
     int            w_tr;
     int            h_tr;
+    int            max_x;           // bounding box of non-zero coefficients in the TU (inclusive)
+    int            max_y;
 } runlevel_t;
 
 /* ---------------------------------------------------------------------------
@@ -803,7 +823,22 @@ typedef struct lcu_info_t {
 
 
 /* ---------------------------------------------------------------------------
- * coding unit */
+ * coding information of one SCU, replicated over all SCUs covered by a CU.
+ * only holds what neighboring CUs, deblocking and SAO/ALF need, so that
+ * the per-SCU array stays dense (8 bytes per SCU) */
+struct scu_t {
+    int8_t      i_cu_level;
+    int8_t      i_cu_type;
+    int8_t      i_slice_nr;
+    int8_t      i_qp;
+    int8_t      i_cbp;
+    int8_t      i_trans_size;         /* tu_split_type_e */
+    int8_t      c_ipred_mode;         /* chroma intra prediction mode */
+    int8_t      reserved;
+};
+
+/* ---------------------------------------------------------------------------
+ * coding unit, only valid at the top-left SCU of each CU */
 struct cu_t {
     /* -------------------------------------------------------------
      * variables needed for neighboring CU decoding */
@@ -865,6 +900,7 @@ typedef struct davs2_output_t {
     int               busy;           /* whether possibly one frame is being delivered */
     int               num_output_pic; /* number of pictures to be output */
     davs2_outpic_t  *pics;           /* output pictures */
+    int               skipped[MAX_SKIPPED_POC];  /* POCs of skipped pictures (indexed by POC % MAX_SKIPPED_POC) */
 } davs2_output_t;
 
 
@@ -915,14 +951,21 @@ struct davs2_mgr_t {
 
     int                 i_tr_wrap_cnt;/* COI wrap count */
     int                 i_prev_coi;   /* previous COI */
+    int                 i_resync;     /* after davs2_decoder_reset(), 1: waiting for an I picture,
+                                       * 2: dropping the pictures not random access decodable */
 
     /* --- decoder output --------- */
     int                 new_sps;      /* is SPS(sequence property set) changed? */
     int                 num_frames_to_output;
 
     /* --- decoding picture buffer (DBP) --------- */
-    davs2_frame_t     **dpb;          /* decoded picture buffer array */
+    davs2_frame_t     **dpb;          /* decoded picture buffer array (NULL: frame not allocated yet) */
     int                 dpbsize;      /* size of the dpb array */
+    int                 dpb_trim_count; /* number of pictures since the last DPB trimming */
+    int                 dpb_min_idle;   /* min number of idle frames since the last DPB trimming */
+
+    /* --- AVS2-S background frames (shared by all tasks, reference counted) --------- */
+    davs2_frame_t      *f_background_ref; /* background frame used for reference (last GB picture) */
 
     /* --- frames to be removed before next frame decoding --------- */
     int     num_frames_to_remove;     /* number of frames to be removed */
@@ -930,12 +973,15 @@ struct davs2_mgr_t {
 
     /* --- lists (input & output) ---------------------------------- */
     xlist_t             packets_idle; /* bit-stream: free buffers for input packets */
+    int                 num_es_units; /* bit-stream: number of buffers allocated (grows on demand) */
+    int                 max_es_units; /* bit-stream: max number of buffers */
 
     xlist_t             pic_recycle;  /* output_picture: free pictures recycle bin */
     davs2_output_t      outpics;      /* output pictures */
 
     /* --- task ---------------------------------------------------- */
     int                 num_decoders;        /* number of decoders in total */
+    int                 num_usable_decoders; /* number of decoders allowed by the memory budget */
     int                 num_active_decoders; /* number of active decoders currently */
     davs2_t            *decoders;            /* frame decoder contexts */
     davs2_t            *h_dec;               /* decoder context for current input bitstream */
@@ -950,6 +996,29 @@ struct davs2_mgr_t {
     davs2_thread_mutex_t    mutex_mgr;         /* a non-recursive mutex */
     davs2_thread_mutex_t    mutex_aec;         /* a non-recursive mutex for AEC */
     void                   *thread_pool;       /* AEC encoding thread */ 
+    davs2_group_t          *group;             /* decoder group sharing the thread pool, NULL: not in a group */
+
+    /* --- memory accounting --------------------------------------- */
+    davs2_thread_mutex_t    mutex_mem;         /* mutex for mem_used[] */
+    int64_t                 mem_used[MEM_TYPE_NUM]; /* allocated bytes of each category, mem_type_e */
+
+    /* --- memory placement ---------------------------------------- */
+    int                     b_huge_pages;      /* back frame buffers with huge pages */
+    int                     i_numa_node;       /* NUMA node of the decoding threads and frame buffers, -1: none */
+};
+
+/* ---------------------------------------------------------------------------
+ * decoder group: decoders sharing one thread pool and the released frames
+ */
+struct davs2_group_t {
+    davs2_thread_mutex_t    mutex;             /* mutex for the members below */
+    int                     i_ref_count;       /* the application handle and the decoders in the group */
+    int                     num_threads;       /* number of threads in the shared pool */
+    void                   *thread_pool;       /* thread pool shared by all decoders in the group */
+
+    /* frames released by the decoders, reused by the decoders of the same resolution */
+    int                     num_cached_frames;
+    davs2_frame_t          *cached_frames[GROUP_MAX_CACHED_FRAMES];
 };
 
 /* ---------------------------------------------------------------------------
@@ -1040,6 +1109,8 @@ struct davs2_t {
     davs2_bs_t   *p_bs;               /* input bitstream pointer */
     aec_t         aec;                /* arithmetic entropy decoder */
     int           decoding_error;     /* ֵʾ˽ */
+    int           i_resync_lcu_xy;    /* error concealment: LCU where the decoding resumes (slice start), -1: none */
+    int           num_concealed_lcus; /* error concealment: number of LCUs concealed in the picture */
 
     /* -------------------------------------------------------------
      * field */
@@ -1096,14 +1167,13 @@ struct davs2_t {
 
     davs2_frame_t *fref[AVS2_MAX_REFS];
     davs2_frame_t *fdec;
-    davs2_frame_t *f_background_cur; /* background reference frame, used for reconstruction */
-    davs2_frame_t *f_background_ref; /* background_frame, used for reference */
     davs2_frame_t *p_frame_sao;      /* used for SAO */
     davs2_frame_t *p_frame_alf;      /* used for ALF */
     lcu_info_t *lcu_infos;            /* LCU level info */
 
     /* -------------------------------------------------------------
      * post processing */
+    int         b_filters_off;        /* skip deblocking, SAO and ALF (non-reference picture in fast preview) */
 
     /* deblock */
     int         b_loop_filter;        /* loop filter enabled? */
@@ -1124,16 +1194,19 @@ struct davs2_t {
     /* -------------------------------------------------------------
      * buffers */
     uint8_t    *p_integral;           /* holder: base pointer for all allocated memory */
+    size_t      i_integral_size;      /* size of the memory charged for p_integral */
 
     /* intra mode */
     int         i_ipredmode;          /* stride */
-    int8_t     *p_ipredmode;          /* intra prediction mode buffer */
+    int         i_spu_row_mask;       /* rows of the rolling neighbor buffers minus 1 (two LCU rows in SPU) */
+    int8_t     *p_ipredmode;          /* intra prediction mode buffer (rolling, indexed by y4 & i_spu_row_mask) */
 
     /* scu */
-    cu_t       *scu_data;
+    scu_t      *scu_data;             /* [scu_xy], neighboring info of each SCU */
+    cu_t       *cu_data;              /* [scu_xy], full CU info, stored at the top-left SCU of each CU */
 
     /* ref & mv & inter prediction direction */
-    int8_t     *p_dirpred;            /* inter prediction direction */
+    int8_t     *p_dirpred;            /* inter prediction direction (rolling, indexed by y4 & i_spu_row_mask) */
     ref_idx_t  *p_ref_idx;            /* reference index */
     mv_t       *p_tmv_1st;            /* motion vector of 4x4 block (1st reference) */
     mv_t       *p_tmv_2nd;            /* motion vector of 4x4 block (2nd reference) */
@@ -1270,6 +1343,15 @@ static ALWAYS_INLINE void davs2_free(void *ptr)
     }
 }
 
+/* ---------------------------------------------------------------------------
+ * large buffers (frames, task buffers) with a placement policy
+ */
+#define HUGE_PAGE_SIZE          (2 * 1024 * 1024)
+#define davs2_malloc_pages FPFX(malloc_pages)
+void *davs2_malloc_pages(size_t i_size, int b_huge_pages, int i_numa_node);
+#define davs2_free_pages   FPFX(free_pages)
+void  davs2_free_pages  (void *ptr);
+
 #if SYS_WINDOWS
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -1436,6 +1518,14 @@ void *xl_remove_head   (xlist_t *const xlist, const int wait);
 #define xl_remove_head_ex FPFX(xl_remove_head_ex)
 void *xl_remove_head_ex(xlist_t *const xlist);
 
+/* ---------------------------------------------------------------------------
+ * memory accounting
+ */
+#define davs2_mem_charge  FPFX(mem_charge)
+int   davs2_mem_charge (davs2_mgr_t *mgr, int type, size_t size, int b_enforce);
+#define davs2_mem_release FPFX(mem_release)
+void  davs2_mem_release(davs2_mgr_t *mgr, int type, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -433,3 +433,78 @@ int davs2_cpu_num_processors(void)
     return 1;
 #endif
 }
+
+#if SYS_LINUX && HAVE_THREAD
+/* ---------------------------------------------------------------------------
+ * get the CPUs of a NUMA node from sysfs (a list such as "0-7,16-23"),
+ * return the number of CPUs
+ */
+static int cpu_get_numa_node_mask(int node, cpu_set_t *p_mask)
+{
+    char path[64];
+    char cpu_list[1024];
+    char *p = cpu_list;
+    FILE *fp;
+    int num_cpus = 0;
+
+    CPU_ZERO(p_mask);
+    sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+    if ((fp = fopen(path, "r")) == NULL) {
+        return 0;
+    }
+    if (fgets(cpu_list, sizeof(cpu_list), fp) == NULL) {
+        cpu_list[0] = '\0';
+    }
+    fclose(fp);
+
+    while (*p >= '0' && *p <= '9') {
+        int first = (int)strtol(p, &p, 10);
+        int last  = first;
+
+        if (*p == '-') {
+            last = (int)strtol(p + 1, &p, 10);
+        }
+        for (; first <= last && first < CPU_SETSIZE; first++) {
+            CPU_SET(first, p_mask);
+            num_cpus++;
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+
+    return num_cpus;
+}
+#endif
+
+/* ---------------------------------------------------------------------------
+ * number of CPUs on a NUMA node, 0 if unknown
+ */
+int davs2_cpu_num_numa_processors(int node)
+{
+#if SYS_LINUX && HAVE_THREAD
+    cpu_set_t mask;
+
+    return cpu_get_numa_node_mask(node, &mask);
+#else
+    UNUSED_PARAMETER(node);
+    return 0;
+#endif
+}
+
+/* ---------------------------------------------------------------------------
+ * pin the calling thread to the CPUs of a NUMA node
+ */
+int davs2_cpu_bind_numa_node(int node)
+{
+#if SYS_LINUX && HAVE_THREAD
+    cpu_set_t mask;
+
+    if (cpu_get_numa_node_mask(node, &mask) > 0) {
+        return sched_setaffinity(0, sizeof(mask), &mask);
+    }
+#else
+    UNUSED_PARAMETER(node);
+#endif
+    return -1;
+}
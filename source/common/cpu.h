@@ -42,6 +42,10 @@ extern "C" {
 uint32_t davs2_cpu_detect(void);
 #define davs2_cpu_num_processors FPFX(cpu_num_processors)
 int  davs2_cpu_num_processors(void);
+#define davs2_cpu_num_numa_processors FPFX(cpu_num_numa_processors)
+int  davs2_cpu_num_numa_processors(int node);
+#define davs2_cpu_bind_numa_node FPFX(cpu_bind_numa_node)
+int  davs2_cpu_bind_numa_node(int node);
 #define avs_cpu_emms FPFX(avs_cpu_emms)
 void avs_cpu_emms(void);
 #define avs_cpu_mask_misalign_sse FPFX(avs_cpu_mask_misalign_sse)
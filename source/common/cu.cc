@@ -271,6 +271,7 @@ void cu_init(davs2_t *h, cu_t *p_cu, int i_level, int scu_xy, int pix_x)
     assert(scu_xy >= 0 && scu_xy < h->i_size_in_scu);
 
     // reset syntax element entries in cu_t
+    p_cu->i_slice_nr    = (int8_t)h->i_slice_index;
     p_cu->i_cu_level    = (int8_t)i_level;
     p_cu->i_qp          = (int8_t)h->i_qp;
     p_cu->i_cu_type     = PRED_SKIP;
@@ -284,7 +285,7 @@ void cu_init(davs2_t *h, cu_t *p_cu, int i_level, int scu_xy, int pix_x)
     h->lcu.c_ipred_mode_ctx = 0;
 
     if (pix_x > 0) {
-        cu_t *p_left_cu = &h->scu_data[scu_xy - 1];
+        scu_t *p_left_cu = &h->scu_data[scu_xy - 1];
 
         if (p_left_cu->i_slice_nr == p_cu->i_slice_nr) {
             h->lcu.c_ipred_mode_ctx = p_left_cu->c_ipred_mode != 0;
@@ -298,23 +299,20 @@ void cu_init(davs2_t *h, cu_t *p_cu, int i_level, int scu_xy, int pix_x)
 static INLINE
 void cu_read_end(davs2_t *h, cu_t *p_cu, int i_level, int scu_xy)
 {
-    cu_t *p_cu_iter = &h->scu_data[scu_xy];
+    scu_t *p_scu_iter = &h->scu_data[scu_xy];
     int size_in_scu = 1 << (i_level - MIN_CU_SIZE_IN_BIT);
-    int i;
-
-    if (size_in_scu <= 1) {
-        return;
-    }
+    scu_t scu;
+    int i, j;
 
-    /* the fist row */
-    for (i = 1; i < size_in_scu; i++) {
-        memcpy(p_cu_iter + i, p_cu, sizeof(cu_t));
-    }
+    /* replicate the neighboring info over all SCUs of the CU, the full CU
+     * info is only kept at the top-left SCU */
+    cu_get_scu(&scu, p_cu);
 
-    /* the left rows */
-    for (i = 1; i < size_in_scu; i++) {
-        p_cu_iter += h->i_width_in_scu;
-        memcpy(p_cu_iter, p_cu, size_in_scu * sizeof(cu_t));
+    for (i = 0; i < size_in_scu; i++) {
+        for (j = 0; j < size_in_scu; j++) {
+            p_scu_iter[j] = scu;
+        }
+        p_scu_iter += h->i_width_in_scu;
     }
 }
 
@@ -324,8 +322,9 @@ static int cu_read_intrapred_mode_luma(davs2_t *h, aec_t *p_aec, cu_t *p_cu, int
 {
     int size_in_scu = 1 << (p_cu->i_cu_level - MIN_CU_SIZE_IN_BIT);
     int i_intramode = h->i_ipredmode;
-    int8_t *p_intramode = h->p_ipredmode + bj * i_intramode + bi;
-    int intra_mode_top  = p_intramode[-i_intramode];
+    int row_mask    = h->i_spu_row_mask;
+    int8_t *p_intramode = h->p_ipredmode + (bj & row_mask) * i_intramode + bi;
+    int intra_mode_top  = h->p_ipredmode[((bj - 1) & row_mask) * i_intramode + bi];
     int intra_mode_left = p_intramode[-1];
     int luma_mode = aec_read_intra_pmode(p_aec);
     int mpm[2];
@@ -413,7 +412,7 @@ void cu_store_references(davs2_t *h, cu_t *p_cu, int pix_x, int pix_y)
 
         i_dir_pred = (int8_t)p_cu->b8pdir[idx_pu];
         ref_idx    = p_cu->ref_idx[idx_pu];
-        p_dirpred  = h->p_dirpred + b8_y * width_in_spu + b8_x;
+        p_dirpred  = h->p_dirpred + (b8_y & h->i_spu_row_mask) * width_in_spu + b8_x;
         p_ref_1st  = h->p_ref_idx + b8_y * width_in_spu + b8_x;
 
         for (r = pu.h; r != 0; r--) {
@@ -431,7 +430,7 @@ void cu_store_references(davs2_t *h, cu_t *p_cu, int pix_x, int pix_y)
  */
 static int cu_read_mv(davs2_t *h, aec_t *p_aec, int i_level, int scu_xy, int pix_x, int pix_y)
 {
-    cu_t *p_cu = &h->scu_data[scu_xy];
+    cu_t *p_cu = &h->cu_data[scu_xy];
     int bframe = (h->i_frame_type == AVS2_B_SLICE);
     int idx_pu;
     int block8_y = pix_y >> MIN_PU_SIZE_IN_BIT;
@@ -1222,7 +1221,7 @@ void decode_lcu_init(davs2_t *h, int i_lcu_x, int i_lcu_y)
 
     // init slice index of current LCU
     for (i = 0; i < lcu_h_in_scu; i++) {
-        cu_t *p_cu_iter = &h->scu_data[h->lcu.i_scu_xy + i * width_in_scu];
+        scu_t *p_cu_iter = &h->scu_data[h->lcu.i_scu_xy + i * width_in_scu];
 
         for (j = 0; j < lcu_w_in_scu; j++) {
             p_cu_iter->i_slice_nr = (int8_t)h->i_slice_index;
@@ -1320,7 +1319,7 @@ int decode_lcu_parse(davs2_t *h, int i_level, int pix_x, int pix_y)
         int i_cu_x  = (pix_x >> MIN_CU_SIZE_IN_BIT);
         int i_cu_y  = (pix_y >> MIN_CU_SIZE_IN_BIT);
         int i_cu_xy = i_cu_y * width_in_scu + i_cu_x;
-        cu_t *p_cu  = &h->scu_data[i_cu_xy];
+        cu_t *p_cu  = &h->cu_data[i_cu_xy];
 
         h->lcu.idx_cu_zscan_aec = tab_b8xy_to_zigzag[i_cu_y - h->lcu.i_scu_y][i_cu_x - h->lcu.i_scu_x];
 
@@ -1342,7 +1341,7 @@ int decode_lcu_recon(davs2_t *h, davs2_row_rec_t *row_rec, int i_level, int pix_
     int i_cu_x     = (pix_x >> MIN_CU_SIZE_IN_BIT);
     int i_cu_y     = (pix_y >> MIN_CU_SIZE_IN_BIT);
     int i_cu_xy    = i_cu_y * width_in_scu + i_cu_x;
-    cu_t *p_cu     = &h->scu_data[i_cu_xy];
+    cu_t *p_cu     = &h->cu_data[i_cu_xy];
     int split_flag = (p_cu->i_cu_level < i_level);
 
     assert((pix_x < h->i_width) && (pix_y < h->i_height));
@@ -1373,3 +1372,137 @@ int decode_lcu_recon(davs2_t *h, davs2_row_rec_t *row_rec, int i_level, int pix_
 
     return 0;
 }
+
+/* ---------------------------------------------------------------------------
+ * fill one plane of a block with the last line above it (mid-grey at the top
+ * of the picture)
+ */
+static void conceal_block_spatial(pel_t *p_dst, int i_dst, int width, int height, int b_top_avail)
+{
+    int i, j;
+
+    if (b_top_avail) {
+        for (j = 0; j < height; j++) {
+            memcpy(p_dst + j * i_dst, p_dst - i_dst, width * sizeof(pel_t));
+        }
+    } else {
+        const pel_t val = (pel_t)(1 << (g_bit_depth - 1));
+
+        for (j = 0; j < height; j++) {
+            for (i = 0; i < width; i++) {
+                p_dst[j * i_dst + i] = val;
+            }
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * conceal a corrupted LCU (error concealment). the samples are predicted by
+ * 16x16 blocks: P/F pictures use the motion of the collocated block in the
+ * first reference scaled to it (as in the temporal skip mode), B pictures
+ * copy the forward reference, pictures without reference extend the line
+ * above. the LCU is stored as one CU of the current slice without residual,
+ * SAO or ALF
+ */
+void decode_lcu_conceal(davs2_t *h, davs2_row_rec_t *row_rec, int i_lcu_x, int i_lcu_y)
+{
+    const int w_in_scu = h->i_width_in_scu;
+    const int w_in_spu = h->i_width_in_spu;
+    const int blk_size = 1 << (MIN_PU_SIZE_IN_BIT + MV_FACTOR_IN_BIT);
+    const int ctu_w    = row_rec->ctu.i_ctu_w;
+    const int ctu_h    = row_rec->ctu.i_ctu_h;
+    lcu_info_t *lcu_info = &h->lcu_infos[i_lcu_y * h->i_width_in_lcu + i_lcu_x];
+    davs2_frame_t *p_fref = NULL;
+    int b_temporal = 0;
+    int x, y, i, j;
+
+    if (h->num_of_references > 0) {
+        if (h->i_frame_type == AVS2_B_SLICE) {
+            p_fref = h->fref[B_FWD];
+        } else {
+            p_fref = h->fref[0];
+            b_temporal = h->i_frame_type == AVS2_P_SLICE || h->i_frame_type == AVS2_F_SLICE;
+        }
+    }
+
+    for (y = 0; y < ctu_h; y += blk_size) {
+        for (x = 0; x < ctu_w; x += blk_size) {
+            int pix_x  = row_rec->ctu.i_pix_x + x;
+            int pix_y  = row_rec->ctu.i_pix_y + y;
+            int width  = DAVS2_MIN(blk_size, ctu_w - x);
+            int height = DAVS2_MIN(blk_size, ctu_h - y);
+            int offset = (pix_y >> MIN_PU_SIZE_IN_BIT) * w_in_spu + (pix_x >> MIN_PU_SIZE_IN_BIT);
+            mv_t mv;
+            ref_idx_t ref_idx;
+
+            mv.v = 0;
+            if (b_temporal && p_fref->refbuf[offset] >= 0) {
+                mv_t tmv     = p_fref->mvbuf[offset];
+                int col_dist = p_fref->dist_scale_refs[p_fref->refbuf[offset]];
+                int cur_dist = get_distance_index_p(h, 0);
+
+                mv.x = scale_mv_skip(h, tmv.x, cur_dist, col_dist);
+                mv.y = scale_mv_skip(h, tmv.y, cur_dist, col_dist);
+            }
+
+            /* motion of the block, for the MV prediction of the following pictures */
+            ref_idx.r[0] = (int8_t)(p_fref != NULL ? 0 : INVALID_REF);
+            ref_idx.r[1] = INVALID_REF;
+            for (j = 0; j < (height >> MIN_PU_SIZE_IN_BIT); j++) {
+                for (i = 0; i < (width >> MIN_PU_SIZE_IN_BIT); i++) {
+                    h->p_tmv_1st[offset + j * w_in_spu + i]   = mv;
+                    h->p_tmv_2nd[offset + j * w_in_spu + i].v = 0;
+                    h->p_ref_idx[offset + j * w_in_spu + i]   = ref_idx;
+                }
+            }
+
+            if (p_fref != NULL) {
+                int i_fdec = row_rec->ctu.i_fdec[IMG_Y];
+
+                cu_get_mc_pos_mv(h, &mv, pix_x, pix_y, width, height);
+                decoder_wait_row(h, p_fref, (mv.y >> 2) + height + 8 + 4);
+
+                mc_luma(h, row_rec->ctu.p_fdec[IMG_Y] + y * i_fdec + x, i_fdec,
+                        mv.x, mv.y, width, height, p_fref->planes[IMG_Y], p_fref->i_stride[IMG_Y]);
+                if (h->i_chroma_format == CHROMA_420) {
+                    i_fdec = row_rec->ctu.i_fdec[IMG_U];
+                    mc_chroma(h, row_rec->ctu.p_fdec[IMG_U] + (y >> 1) * i_fdec + (x >> 1), i_fdec,
+                              mv.x, mv.y, width >> 1, height >> 1, p_fref->planes[IMG_U], p_fref->i_stride[IMG_U]);
+                    i_fdec = row_rec->ctu.i_fdec[IMG_V];
+                    mc_chroma(h, row_rec->ctu.p_fdec[IMG_V] + (y >> 1) * i_fdec + (x >> 1), i_fdec,
+                              mv.x, mv.y, width >> 1, height >> 1, p_fref->planes[IMG_V], p_fref->i_stride[IMG_V]);
+                }
+            }
+        }
+    }
+
+    if (p_fref == NULL) {
+        int b_top_avail = row_rec->ctu.i_pix_y > 0;
+
+        conceal_block_spatial(row_rec->ctu.p_fdec[IMG_Y], row_rec->ctu.i_fdec[IMG_Y], ctu_w, ctu_h, b_top_avail);
+        conceal_block_spatial(row_rec->ctu.p_fdec[IMG_U], row_rec->ctu.i_fdec[IMG_U], row_rec->ctu.i_ctu_w_c, row_rec->ctu.i_ctu_h_c, b_top_avail);
+        conceal_block_spatial(row_rec->ctu.p_fdec[IMG_V], row_rec->ctu.i_fdec[IMG_V], row_rec->ctu.i_ctu_w_c, row_rec->ctu.i_ctu_h_c, b_top_avail);
+    }
+
+    /* one CU without residual, not available to the LCUs of the other slices */
+    for (j = 0; j < (ctu_h >> MIN_CU_SIZE_IN_BIT); j++) {
+        scu_t *p_scu = &h->scu_data[row_rec->ctu.i_scu_xy + j * w_in_scu];
+
+        for (i = 0; i < (ctu_w >> MIN_CU_SIZE_IN_BIT); i++, p_scu++) {
+            p_scu->i_cu_level   = (int8_t)h->i_lcu_level;
+            p_scu->i_cu_type    = (int8_t)(p_fref != NULL ? PRED_SKIP : PRED_I_2Nx2N);
+            p_scu->i_slice_nr   = (int8_t)h->i_slice_index;
+            p_scu->i_qp         = (int8_t)h->i_qp;
+            p_scu->i_cbp        = 0;
+            p_scu->i_trans_size = TU_SPLIT_NON;
+            p_scu->c_ipred_mode = DC_PRED_C;
+        }
+    }
+
+    for (i = 0; i < IMG_COMPONENTS; i++) {
+        lcu_info->sao_param.planes[i].modeIdc = SAO_MODE_OFF;
+        lcu_info->enable_alf[i] = FALSE;
+    }
+
+    h->num_concealed_lcus++;
+}
@@ -71,6 +71,12 @@ int  decode_lcu_parse(davs2_t *h, int i_level, int pix_x, int pix_y);
 #define decode_lcu_recon FPFX(decode_lcu_recon)
 int  decode_lcu_recon(davs2_t *h, davs2_row_rec_t *row_rec, int i_level, int pix_x, int pix_y);
 
+/* ---------------------------------------------------------------------------
+ * conceal a corrupted LCU from the nearest reference (error concealment)
+ */
+#define decode_lcu_conceal FPFX(decode_lcu_conceal)
+void decode_lcu_conceal(davs2_t *h, davs2_row_rec_t *row_rec, int i_lcu_x, int i_lcu_y);
+
 #define decoder_wait_lcu_row FPFX(decoder_wait_lcu_row)
 void decoder_wait_lcu_row(davs2_t *h, davs2_frame_t *frame, int max_y_in_pic);
 #define decoder_wait_row FPFX(decoder_wait_row)
@@ -42,6 +42,7 @@
 #include "cpu.h"
 #include "threadpool.h"
 #include "version.h"
+#include "aec.h"
 
 /**
  * ===========================================================================
@@ -60,18 +61,33 @@ FILE *fp_trace_in = NULL;
  * ===========================================================================
  */
 
+/* --------------------------------------------------------------------------
+ */
+static INLINE int
+es_unit_get_size(int buf_size)
+{
+    int bufsize = sizeof(es_unit_t) + buf_size;
+
+    return ((bufsize + 31) >> 5 ) << 5;
+}
+
 /* --------------------------------------------------------------------------
  */
 static es_unit_t *
-es_unit_alloc(int buf_size)
+es_unit_alloc(davs2_mgr_t *mgr, int buf_size)
 {
     es_unit_t *es_unit = NULL;
-    int bufsize = sizeof(es_unit_t) + buf_size;
-    
-    bufsize = ((bufsize + 31) >> 5 ) << 5;
+    int bufsize = es_unit_get_size(buf_size);
+
+    if (davs2_mem_charge(mgr, MEM_BITSTREAM, bufsize, 1) < 0) {
+        davs2_log(mgr, DAVS2_LOG_ERROR, "memory budget exceeded, failed to allocate an ES unit of %d bytes.\n", bufsize);
+        return NULL;
+    }
+
     es_unit = (es_unit_t *)davs2_malloc(bufsize);
 
     if (es_unit == NULL) {
+        davs2_mem_release(mgr, MEM_BITSTREAM, bufsize);
         davs2_log(NULL, DAVS2_LOG_ERROR, "failed to malloc memory in es_unit_alloc.\n");
         return NULL;
     }
@@ -87,13 +103,37 @@ es_unit_alloc(int buf_size)
 /* --------------------------------------------------------------------------
  */
 static void
-es_unit_free(es_unit_t *es_unit)
+es_unit_free(davs2_mgr_t *mgr, es_unit_t *es_unit)
 {
     if (es_unit) {
+        davs2_mem_release(mgr, MEM_BITSTREAM, es_unit_get_size(es_unit->size));
         davs2_free(es_unit);
     }
 }
 
+/* --------------------------------------------------------------------------
+ * get an idle ES unit, a new one is allocated while the max number is not
+ * reached, otherwise wait for one to be released by the decoding tasks
+ */
+static es_unit_t *
+es_unit_get(davs2_mgr_t *mgr)
+{
+    es_unit_t *es_unit = (es_unit_t *)xl_remove_head(&mgr->packets_idle, 0);
+
+    if (es_unit == NULL && mgr->num_es_units < mgr->max_es_units) {
+        if ((es_unit = es_unit_alloc(mgr, MAX_ES_FRAME_SIZE)) != NULL) {
+            mgr->num_es_units++;
+            return es_unit;
+        }
+    }
+
+    if (es_unit == NULL) {
+        es_unit = (es_unit_t *)xl_remove_head(&mgr->packets_idle, 1);
+    }
+
+    return es_unit;
+}
+
 /* ---------------------------------------------------------------------------
  * push byte stream data of one frame to input list
  */
@@ -106,10 +146,12 @@ es_unit_t *davs2_pack_es_unit(davs2_mgr_t *mgr, const uint8_t *data, int len, in
     int start_code = data[3];
 
     if (mgr->es_unit == NULL) {
-        mgr->es_unit = (es_unit_t *)xl_remove_head(&mgr->packets_idle, 1);
+        mgr->es_unit = es_unit_get(mgr);
     }
 
-    es_unit = mgr->es_unit;
+    if ((es_unit = mgr->es_unit) == NULL) {
+        return NULL;
+    }
 
     if (len > 0) {
         if (es_unit->size < es_unit->len + len) {
@@ -117,14 +159,15 @@ es_unit_t *davs2_pack_es_unit(davs2_mgr_t *mgr, const uint8_t *data, int len, in
             int new_size = es_unit->len + len + MAX_ES_FRAME_SIZE * 2;
             es_unit_t *new_es_unit;
 
-            if ((new_es_unit = es_unit_alloc(new_size)) == NULL) {
+            if ((new_es_unit = es_unit_alloc(mgr, new_size)) == NULL) {
                 return NULL;
             }
 
             memcpy(new_es_unit, es_unit, sizeof(es_unit_t));   /* copy ES Unit information */
+            new_es_unit->size = new_size;
             memcpy(new_es_unit->data, es_unit->data, es_unit->len * sizeof(uint8_t));
 
-            es_unit_free(es_unit);
+            es_unit_free(mgr, es_unit);
 
             mgr->es_unit = es_unit = new_es_unit;
         }
@@ -133,7 +176,7 @@ es_unit_t *davs2_pack_es_unit(davs2_mgr_t *mgr, const uint8_t *data, int len, in
         if (DAVS2_ISUNIT(start_code) && es_unit->len > 0) {
             ret_es_unit = es_unit;
             /* fetch a node again from idle list */
-            es_unit = (es_unit_t *)xl_remove_head(&mgr->packets_idle, 1);
+            es_unit = es_unit_get(mgr);
             mgr->es_unit = es_unit;
         }
         memcpy(es_unit->data + es_unit->len, data, len * sizeof(uint8_t));
@@ -157,7 +200,7 @@ static void
 destroy_all_lists(davs2_mgr_t *mgr)
 {
     es_unit_t *es_unit = NULL;
-    davs2_picture_t *pic = NULL;
+    davs2_outpic_t *pic = NULL;
 
     /* idle list */
     for (;;) {
@@ -165,20 +208,20 @@ destroy_all_lists(davs2_mgr_t *mgr)
             break;
         }
 
-        es_unit_free(es_unit);
+        es_unit_free(mgr, es_unit);
     }
 
     /* recycle list */
     for (;;) {
-        if ((pic = (davs2_picture_t *)xl_remove_head_ex(&mgr->pic_recycle)) == NULL) {
+        if ((pic = (davs2_outpic_t *)xl_remove_head_ex(&mgr->pic_recycle)) == NULL) {
             break;
         }
 
-        davs2_free(pic);
+        free_picture(mgr, pic);
     }
 
     if (mgr->es_unit) {
-        es_unit_free(mgr->es_unit);
+        es_unit_free(mgr, mgr->es_unit);
         mgr->es_unit = NULL;
     }
 
@@ -199,8 +242,17 @@ create_all_lists(davs2_mgr_t *mgr)
         goto fail;
     }
 
-    for (i = 0; i < MAX_ES_FRAME_NUM + mgr->param.threads; i++) {
-        es_unit = es_unit_alloc(MAX_ES_FRAME_SIZE);
+    /* at most one ES unit per task is in use (plus the one being packed),
+     * so only that many are kept when a memory budget is given */
+    mgr->max_es_units = MAX_ES_FRAME_NUM + mgr->param.threads;
+    if (mgr->param.max_memory > 0) {
+        mgr->max_es_units = mgr->num_decoders + 2;
+    }
+
+    /* the others are allocated on demand */
+    mgr->num_es_units = 2;
+    for (i = 0; i < mgr->num_es_units; i++) {
+        es_unit = es_unit_alloc(mgr, MAX_ES_FRAME_SIZE);
 
         if (es_unit) {
             xl_append(&mgr->packets_idle, es_unit);
@@ -252,7 +304,12 @@ davs2_outpic_t *output_list_get_one_output_picture(davs2_mgr_t *mgr)
         davs2_frame_t *frame = mgr->outpics.pics->frame;
         assert(frame);
 
-        if (frame->i_poc == mgr->outpics.output) {
+        if (mgr->outpics.skipped[mgr->outpics.output % MAX_SKIPPED_POC] == mgr->outpics.output) {
+            /* the next frame is skipped */
+            mgr->outpics.skipped[mgr->outpics.output % MAX_SKIPPED_POC] = INVALID_FRAME;
+            mgr->outpics.output++;
+            continue;
+        } else if (frame->i_poc == mgr->outpics.output) {
             /* the next frame : output */
             pic = mgr->outpics.pics;
             mgr->outpics.pics = pic->next;
@@ -395,7 +452,7 @@ static davs2_t *task_get_free_task(davs2_mgr_t *mgr)
     int i;
 
     for (; mgr->b_exit == 0;) {
-        for (i = 0; i < mgr->num_decoders; i++) {
+        for (i = 0; i < mgr->num_usable_decoders; i++) {
             davs2_t *h = &mgr->decoders[i];
             davs2_thread_mutex_lock(&mgr->mutex_mgr);
             if (h->task_info.task_status == TASK_FREE) {
@@ -423,10 +480,121 @@ void task_unload_packet(davs2_t *h, es_unit_t *es_unit)
     }
 
     davs2_thread_mutex_lock(&mgr->mutex_mgr);
+    if (h->task_info.task_id >= mgr->num_usable_decoders) {
+        /* task is no longer used due to the memory budget */
+        decoder_free_extra_buffer(h);
+    }
     h->task_info.task_status = TASK_FREE;
     davs2_thread_mutex_unlock(&mgr->mutex_mgr);
 }
 
+/* ---------------------------------------------------------------------------
+ * init function of the pool threads: pin the thread to the NUMA node
+ */
+static
+void *decoder_thread_bind_numa_node(void *arg1, int numa_node)
+{
+    if (davs2_cpu_bind_numa_node(numa_node) < 0) {
+        davs2_log(arg1, DAVS2_LOG_WARNING, "failed to pin a decoding thread to NUMA node %d\n", numa_node);
+    }
+
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * drop a reference of a decoder group, destroy it with the last one
+ */
+static
+void group_unref(davs2_group_t *group)
+{
+    int b_destroy;
+    int i;
+
+    davs2_thread_mutex_lock(&group->mutex);
+    b_destroy = --group->i_ref_count == 0;
+    davs2_thread_mutex_unlock(&group->mutex);
+
+    if (!b_destroy) {
+        return;
+    }
+
+    if (group->thread_pool != NULL) {
+        davs2_threadpool_delete((davs2_threadpool_t *)group->thread_pool);
+    }
+
+    for (i = 0; i < group->num_cached_frames; i++) {
+        davs2_frame_destroy(group->cached_frames[i]);
+    }
+
+    davs2_thread_mutex_destroy(&group->mutex);
+    davs2_free(group);
+}
+
+/* ---------------------------------------------------------------------------
+ * one-time initialization of the process-wide tables (function handles and
+ * AEC context transitions), safe when decoders are opened concurrently.
+ * the SIMD level is set by the first decoder opened, returns -1 if the
+ * requested one (disable_avx) differs from it
+ */
+static
+int davs2_global_init(int disable_avx)
+{
+    static int init_state = 0;              /* 0: not initialized, 1: initializing, 2: done */
+    static int init_disable_avx = 0;        /* SIMD level of the function handles */
+    uint32_t cpuid = 0;
+
+#if HAVE_MMX
+    disable_avx = DAVS2_CLIP3(0, 2, disable_avx);
+#else
+    disable_avx = 0;            /* C functions only anyway */
+#endif
+
+    if (davs2_atomic_load_acquire(&init_state) == 2) {
+        return disable_avx == init_disable_avx ? 0 : -1;
+    }
+
+    if (!davs2_atomic_cas(&init_state, 0, 1)) {
+        /* another thread is initializing */
+        while (davs2_atomic_load_acquire(&init_state) != 2) {
+            davs2_sleep_ms(1);
+        }
+        return disable_avx == init_disable_avx ? 0 : -1;
+    }
+
+#if HAVE_MMX
+    cpuid = davs2_cpu_detect();
+    if (disable_avx) {
+         cpuid &= ~(DAVS2_CPU_AVX | DAVS2_CPU_AVX2);
+    }
+    if (disable_avx > 1) {
+        cpuid = 0;              /* C functions only */
+    }
+#endif
+    init_all_primitives(cpuid);
+    init_aec_context_tab();
+    init_disable_avx = disable_avx;
+
+    davs2_atomic_store_release(&init_state, 2);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * create the thread pool of a decoder not in a group, done on the first
+ * picture so that opening a decoder does not spawn any thread
+ */
+static
+int decoder_create_thread_pool(davs2_mgr_t *mgr)
+{
+    if (davs2_threadpool_init((davs2_threadpool_t **)&mgr->thread_pool, mgr->num_total_thread,
+                              mgr->i_numa_node >= 0 ? decoder_thread_bind_numa_node : NULL, mgr, mgr->i_numa_node) < 0) {
+        mgr->thread_pool = NULL;
+        davs2_log(mgr, DAVS2_LOG_ERROR, "failed to create the thread pool of %d thread(s)\n", mgr->num_total_thread);
+        return -1;
+    }
+
+    return 0;
+}
+
 
 /**
  * ===========================================================================
@@ -444,7 +612,6 @@ davs2_decoder_open(davs2_param_t *param)
     davs2_mgr_t *mgr = NULL;
     uint8_t *mem_ptr;
     size_t mem_size;
-    uint32_t cpuid = 0;
     int i;
 
     /* output version information */
@@ -464,17 +631,15 @@ davs2_decoder_open(davs2_param_t *param)
         return 0;
     }
 
-    /* init all function handlers */
-#if HAVE_MMX
-    cpuid = davs2_cpu_detect();
-    if (param->disable_avx) {
-         cpuid &= ~(DAVS2_CPU_AVX | DAVS2_CPU_AVX2);
+    /* init all function handlers (once per process) */
+    if (davs2_global_init(param->disable_avx) < 0) {
+        davs2_log(NULL, DAVS2_LOG_ERROR, "disable_avx (%d) differs from the SIMD level set by the first decoder opened",
+                  param->disable_avx);
+        return 0;
     }
-#endif
-    init_all_primitives(cpuid);
 
     /* CPU capacities */
-    davs2_get_simd_capabilities(buf_cpu, cpuid);
+    davs2_get_simd_capabilities(buf_cpu, gf_davs2.cpuid);
     if (param->info_level <= DAVS2_LOG_INFO) {
         davs2_log(mgr, DAVS2_LOG_INFO, "CPU Capabilities: %s", buf_cpu);
     }
@@ -492,8 +657,29 @@ davs2_decoder_open(davs2_param_t *param)
     mgr->module_log.i_log_level = param->info_level;
     sprintf(mgr->module_log.module_name, "Manager %06llx", (long long unsigned int)(mgr));
 
+    /* output pictures: full size, 1/2 or 1/4 */
+    mgr->param.output_scale = DAVS2_CLIP3(0, 2, mgr->param.output_scale);
+
+    /* memory placement and thread binding */
+    mgr->b_huge_pages = mgr->param.huge_pages > 0;
+    mgr->i_numa_node  = mgr->param.numa_node > 0 ? mgr->param.numa_node - 1 : -1;
+    if (mgr->i_numa_node >= 0 && davs2_cpu_num_numa_processors(mgr->i_numa_node) <= 0) {
+        davs2_log(mgr, DAVS2_LOG_WARNING, "NUMA node %d is not available, binding disabled\n", mgr->i_numa_node);
+        mgr->i_numa_node = -1;
+    }
+
+    /* decoder group */
+    mgr->group = (davs2_group_t *)mgr->param.group;
+    if (mgr->group != NULL && mgr->param.threads <= 0) {
+        mgr->param.threads = 2;     /* frames in parallel, the threads are shared */
+    }
+
     if (mgr->param.threads <= 0) {
-        mgr->param.threads = davs2_cpu_num_processors();
+        if (mgr->i_numa_node >= 0) {
+            mgr->param.threads = davs2_cpu_num_numa_processors(mgr->i_numa_node);
+        } else {
+            mgr->param.threads = davs2_cpu_num_processors();
+        }
     }
     if (mgr->param.threads > max_num_thread) {
         mgr->param.threads = max_num_thread;
@@ -507,6 +693,9 @@ davs2_decoder_open(davs2_param_t *param)
     mgr->outpics.output   = -1;
     mgr->outpics.pics     = NULL;
     mgr->outpics.num_output_pic = 0;
+    for (i = 0; i < MAX_SKIPPED_POC; i++) {
+        mgr->outpics.skipped[i] = INVALID_FRAME;
+    }
 
     mgr->num_decoders     = mgr->param.threads;
     mgr->num_total_thread = mgr->param.threads;
@@ -524,12 +713,22 @@ davs2_decoder_open(davs2_param_t *param)
 #endif
 
     mgr->num_decoders++;
+    mgr->num_usable_decoders = mgr->num_decoders;
 
     mgr->decoders = (davs2_t *)mem_ptr;
     mem_ptr      += AVS2_THREAD_MAX * sizeof(davs2_t);
     ALIGN_POINTER(mem_ptr);
     davs2_thread_mutex_init(&mgr->mutex_mgr, NULL);
     davs2_thread_mutex_init(&mgr->mutex_aec, NULL);
+    davs2_thread_mutex_init(&mgr->mutex_mem, NULL);
+
+    /* memory budget */
+    mgr->mem_used[MEM_CONTEXT] = (int64_t)mem_size;
+    if (mgr->param.max_memory > 0 && mgr->param.max_memory < (int64_t)mem_size) {
+        davs2_log(mgr, DAVS2_LOG_ERROR, "memory budget of %lld bytes is too small, %lld bytes needed for the decoder context\n",
+                  (long long)mgr->param.max_memory, (long long)mem_size);
+        goto fail;
+    }
 
     /* init input&output lists */
     if (create_all_lists(mgr) < 0) {
@@ -564,7 +763,16 @@ davs2_decoder_open(davs2_param_t *param)
     }
 
     /* initialize thread pool for AEC decoding and reconstruction */
-    davs2_threadpool_init((davs2_threadpool_t **)&mgr->thread_pool, mgr->num_total_thread, NULL, NULL, 0);
+    if (mgr->group != NULL) {
+        davs2_group_t *group = mgr->group;
+
+        davs2_thread_mutex_lock(&group->mutex);
+        group->i_ref_count++;
+        davs2_thread_mutex_unlock(&group->mutex);
+        mgr->thread_pool = group->thread_pool;
+        davs2_log(mgr, DAVS2_LOG_INFO, "joined decoder group %p: %d shared thread(s)", group, group->num_threads);
+    }
+    /* otherwise the pool is created with the first picture to decode */
 
     davs2_log(mgr, DAVS2_LOG_INFO, "using %d thread(s): %d(frame/AEC)+%d(pool/REC), %d tasks", 
         mgr->num_total_thread, mgr->num_aec_thread, mgr->num_rec_thread, mgr->num_decoders);
@@ -578,6 +786,50 @@ fail:
     return NULL;
 }
 
+/* ---------------------------------------------------------------------------
+ * is the picture whose header was just parsed skipped (davs2_skip_frame_e) ?
+ */
+static INLINE
+int decoder_is_skipped_picture(davs2_t *h, int skip_frame)
+{
+    switch (skip_frame) {
+    case DAVS2_SKIP_NONREF:
+        return h->rps.refered_by_others == 0;
+    case DAVS2_SKIP_NONINTRA:
+        return h->i_frame_type != AVS2_I_SLICE && h->i_frame_type != AVS2_G_SLICE && h->i_frame_type != AVS2_GB_SLICE;
+    case DAVS2_SKIP_NONKEY:
+        return h->i_frame_type != AVS2_I_SLICE;
+    default:
+        return 0;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * after davs2_decoder_reset(), is the picture whose header was just parsed one
+ * of the pictures following the random access point which refer to pictures
+ * before it ?
+ */
+static INLINE
+int decoder_is_undecodable_after_reset(davs2_mgr_t *mgr, davs2_t *h)
+{
+    if (mgr->i_resync == 0) {
+        return 0;
+    }
+
+    if (h->i_frame_type == AVS2_I_SLICE || h->i_frame_type == AVS2_G_SLICE || h->i_frame_type == AVS2_GB_SLICE) {
+        /* the random access point, then the next I picture ends the resync */
+        mgr->i_resync = mgr->i_resync == 1 ? 2 : 0;
+        return 0;
+    }
+
+    /* no random access point yet: nothing can be decoded without references */
+    if (mgr->i_resync == 1) {
+        return 1;
+    }
+
+    return !h->b_ra_decodable;
+}
+
 /* ---------------------------------------------------------------------------
  */
 int decoder_decode_es_unit(davs2_mgr_t *mgr, es_unit_t *es_unit)
@@ -599,9 +851,17 @@ int decoder_decode_es_unit(davs2_mgr_t *mgr, es_unit_t *es_unit)
     /* (2) parse header */
     if (parse_header(h, &es_unit->bs) == 0) {
         h->p_bs = &es_unit->bs;
+        if (decoder_is_skipped_picture(h, mgr->param.skip_frame) || decoder_is_undecodable_after_reset(mgr, h)) {
+            /* drop this picture before any frame is allocated for it */
+            task_skip_picture(h);
+            davs2_thread_mutex_unlock(&mgr->mutex_aec);
+            task_unload_packet(h, es_unit);
+            return 0;
+        }
         /* TODO: ͼͷϢȷǰʱǷҪͼ */
         /* prepare the reference list and the reconstruction buffer */
-        if (task_get_references(h, es_unit->pts, es_unit->dts) == 0) {
+        if ((mgr->thread_pool != NULL || decoder_create_thread_pool(mgr) == 0) &&
+            task_get_references(h, es_unit->pts, es_unit->dts) == 0) {
             b_wait_output = has_new_output_frame(mgr, h);
             mgr->num_frames_in++;
 
@@ -761,6 +1021,85 @@ davs2_decoder_flush(void *decoder, davs2_seq_info_t *headerset, davs2_picture_t
     }
 }
 
+/* ---------------------------------------------------------------------------
+ */
+DAVS2_API void
+davs2_decoder_reset(void *decoder)
+{
+    davs2_mgr_t    *mgr = (davs2_mgr_t *)decoder;
+    davs2_outpic_t *pic = NULL;
+    int i;
+
+    if (mgr == NULL) {
+        return;
+    }
+
+    /* drop the buffered bit-stream */
+    if (mgr->es_unit != NULL) {
+        mgr->es_unit->len = 0;
+    }
+
+    /* wait for the pictures under decoding */
+    for (i = 0; i < mgr->num_decoders; i++) {
+        while (mgr->decoders[i].task_info.task_status != TASK_FREE) {
+            davs2_sleep_ms(1);
+        }
+    }
+
+    davs2_thread_mutex_lock(&mgr->mutex_mgr);
+
+    /* drop the pictures not output yet */
+    while ((pic = mgr->outpics.pics) != NULL) {
+        mgr->outpics.pics = pic->next;
+        release_one_frame(pic->frame);
+        output_list_recycle_picture(mgr, pic);
+    }
+
+    mgr->outpics.output = -1;   /* an I picture is expected */
+    mgr->outpics.num_output_pic = 0;
+    mgr->outpics.busy = 0;
+    for (i = 0; i < MAX_SKIPPED_POC; i++) {
+        mgr->outpics.skipped[i] = INVALID_FRAME;
+    }
+
+    dpb_reset(mgr);
+
+    davs2_thread_mutex_unlock(&mgr->mutex_mgr);
+
+    mgr->i_tr_wrap_cnt        = 0;
+    mgr->i_prev_coi           = -1;
+    mgr->i_resync             = 1;
+    mgr->b_flushing           = 0;
+    mgr->num_frames_in        = 0;
+    mgr->num_frames_out       = 0;
+    mgr->num_frames_to_output = 0;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+DAVS2_API int
+davs2_decoder_get_memory_info(void *decoder, davs2_memory_info_t *info)
+{
+    davs2_mgr_t *mgr = (davs2_mgr_t *)decoder;
+
+    if (mgr == NULL || info == NULL) {
+        return -1;
+    }
+
+    davs2_thread_mutex_lock(&mgr->mutex_mem);
+    info->context      = mgr->mem_used[MEM_CONTEXT];
+    info->frames       = mgr->mem_used[MEM_FRAMES];
+    info->task_buffers = mgr->mem_used[MEM_TASK_BUFFERS];
+    info->bitstream    = mgr->mem_used[MEM_BITSTREAM];
+    info->output       = mgr->mem_used[MEM_OUTPUT];
+    davs2_thread_mutex_unlock(&mgr->mutex_mem);
+
+    info->total  = info->context + info->frames + info->task_buffers + info->bitstream + info->output;
+    info->budget = mgr->param.max_memory > 0 ? mgr->param.max_memory : 0;
+
+    return 0;
+}
+
 /* ---------------------------------------------------------------------------
  */
 DAVS2_API void
@@ -783,7 +1122,14 @@ davs2_decoder_close(void *decoder)
     mgr->b_exit = 1;
 
     /* destroy thread pool */
-    if (mgr->num_total_thread != 0) {
+    if (mgr->group != NULL && mgr->thread_pool != NULL) {
+        /* the shared pool keeps running, wait for the pictures of this decoder in it */
+        for (i = 0; i < mgr->num_decoders; i++) {
+            while (mgr->decoders[i].task_info.task_status != TASK_FREE) {
+                davs2_sleep_ms(1);
+            }
+        }
+    } else if (mgr->num_total_thread != 0 && mgr->thread_pool != NULL) {
         davs2_threadpool_delete((davs2_threadpool_t *)mgr->thread_pool);
     }
 
@@ -798,9 +1144,15 @@ davs2_decoder_close(void *decoder)
     destroy_all_lists(mgr);     /* free all lists */
     destroy_dpb(mgr);           /* free dpb */
 
+    /* leave the group */
+    if (mgr->group != NULL && mgr->thread_pool != NULL) {
+        group_unref(mgr->group);
+    }
+
     /* destroy the mutex */
     davs2_thread_mutex_destroy(&mgr->mutex_mgr);
     davs2_thread_mutex_destroy(&mgr->mutex_aec);
+    davs2_thread_mutex_destroy(&mgr->mutex_mem);
 
     /* free memory */
     davs2_free(mgr);          /* free the mgr */
@@ -816,3 +1168,58 @@ davs2_decoder_close(void *decoder)
     }
 #endif
 }
+
+/* ---------------------------------------------------------------------------
+ */
+DAVS2_API void *
+davs2_group_open(int threads)
+{
+    davs2_group_t *group = NULL;
+
+    if (threads <= 0) {
+        threads = davs2_cpu_num_processors();
+    }
+
+    CHECKED_MALLOCZERO(group, davs2_group_t *, sizeof(davs2_group_t));
+
+    davs2_thread_mutex_init(&group->mutex, NULL);
+    group->i_ref_count = 1;     /* the application handle */
+    group->num_threads = DAVS2_MIN(threads, AVS2_THREAD_MAX);
+
+    /* the frames of all the decoders in the group are decoded in this pool in
+     * submission order, so that no stream is starved and a picture never waits
+     * for a reference frame queued after it */
+    if (davs2_threadpool_init((davs2_threadpool_t **)&group->thread_pool, group->num_threads, NULL, NULL, 0) < 0) {
+        group->thread_pool = NULL;
+        group_unref(group);
+        goto fail;
+    }
+
+    return group;
+
+fail:
+    davs2_log(NULL, DAVS2_LOG_ERROR, "failed to open decoder group\n");
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+DAVS2_API void
+davs2_group_close(void *group)
+{
+    if (group != NULL) {
+        group_unref((davs2_group_t *)group);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ */
+DAVS2_API int
+davs2_find_split_points(const uint8_t *data, int len, int *offsets, int max_offsets)
+{
+    if (data == NULL || offsets == NULL || len < 4 || max_offsets <= 0) {
+        return 0;
+    }
+
+    return find_random_access_points(data, len, offsets, max_offsets);
+}
@@ -143,7 +143,7 @@ static void lf_set_edge_filter_param(davs2_t *h, int i_level, int scu_x, int scu
 static void lf_lcu_set_edge_filter(davs2_t *h, int i_level, int scu_x, int scu_y)
 {
     const int w_in_scu = h->i_width_in_scu;
-    cu_t *p_scu_data = &h->scu_data[scu_y * w_in_scu + scu_x];
+    scu_t *p_scu_data = &h->scu_data[scu_y * w_in_scu + scu_x];
     int i;
 
     if (p_scu_data->i_cu_level < i_level) {
@@ -254,7 +254,7 @@ static void lf_lcu_set_edge_filter(davs2_t *h, int i_level, int scu_x, int scu_y
 /* ---------------------------------------------------------------------------
  * return 1 if skip filtering is needed
  */
-static uint8_t lf_skip_filter(davs2_t *h, cu_t *scuP, cu_t *scuQ, int dir, int block_x, int block_y)
+static uint8_t lf_skip_filter(davs2_t *h, scu_t *scuP, scu_t *scuQ, int dir, int block_x, int block_y)
 {
     if (h->i_frame_type == AVS2_P_SLICE || h->i_frame_type == AVS2_F_SLICE) {
         const int width_in_spu = h->i_width_in_spu;
@@ -416,13 +416,13 @@ static void lf_scu_deblock(davs2_t *h, pel_t *p_dec[3], int stride, int stride_c
 {
     static const int max_qp_deblock = 63;
     const int scu_xy   = scu_y * h->i_width_in_scu + scu_x;
-    cu_t     *scuQ     = &h->scu_data[scu_xy];
+    scu_t    *scuQ     = &h->scu_data[scu_xy];
     int edge_condition = h->p_deblock_flag[dir][scu_xy];
 
     /* deblock edges */
     if (edge_condition != EDGE_TYPE_NOFILTER) {
         const int shift = h->sample_bit_depth - 8;
-        cu_t  *scuP  = (dir) ? (scuQ - h->i_width_in_scu) : (scuQ - 1);
+        scu_t *scuP  = (dir) ? (scuQ - h->i_width_in_scu) : (scuQ - 1);
         uint8_t b_filter_flag[2];
         int QP;
 
@@ -73,11 +73,14 @@ static void init_frame(davs2_t *h)
     h->i_slice_index       = -1;
     h->b_slice_checked     = 0;
     h->fdec->i_parsed_lcu_xy = -1;
+    h->i_resync_lcu_xy     = -1;
+    h->num_concealed_lcus  = 0;
     h->decoding_error      = 0;    // ־
+    h->b_filters_off       = h->task_info.taskmgr->param.fast_preview && !h->rps.refered_by_others;
 
     /* 1, clear intra_mode buffer, set to default value (-1) */
-    memset(h->p_ipredmode - h->i_ipredmode - 16, DC_PRED, h->i_ipredmode * (h->i_height_in_spu + 1) * sizeof(int8_t));
-    memset(h->p_dirpred, PDIR_INVALID, num_spu * sizeof(int8_t));
+    memset(h->p_ipredmode - 16, DC_PRED, h->i_ipredmode * (h->i_spu_row_mask + 1) * sizeof(int8_t));
+    memset(h->p_dirpred, PDIR_INVALID, h->i_width_in_spu * (h->i_spu_row_mask + 1) * sizeof(int8_t));
 
     /* 2, clear mv buffer (set all MVs to zero) */
     gf_davs2.fast_memzero(h->p_ref_idx, num_spu * sizeof(ref_idx_t));
@@ -97,10 +100,10 @@ static void init_frame(davs2_t *h)
     }
 
     /* 5, copy frame properties for SAO & ALF */
-    if (h->b_sao) {
+    if (h->b_sao && !h->b_filters_off) {
         davs2_frame_copy_properties(h->p_frame_sao, h->fdec);
     }
-    if (h->b_alf) {
+    if (h->b_alf && !h->b_filters_off) {
         int alf_enable = h->pic_alf_on[IMG_Y] != 0 || h->pic_alf_on[IMG_U] != 0 || h->pic_alf_on[IMG_V] != 0;
         if (alf_enable) {
             davs2_frame_copy_properties(h->p_frame_alf, h->fdec);
@@ -209,13 +212,13 @@ static davs2_outpic_t *get_one_free_picture(davs2_mgr_t *mgr, int w, int h)
         }
 
         /* obsolete picture */
-        free_picture(pic);
+        free_picture(mgr, pic);
         pic = NULL;
     }
 
     if (pic == NULL) {
         /* no free picture. no wait, just new one. */
-        pic = alloc_picture(w, h);
+        pic = alloc_picture(mgr, w, h);
     }
 
     return pic;
@@ -323,54 +326,111 @@ void task_output_decoding_frame(davs2_t *h)
 
     assert(frame);
 
-    pic = get_one_free_picture(mgr, h->i_image_width, h->i_image_height);
+    pic = get_one_free_picture(mgr, h->i_image_width >> mgr->param.output_scale, h->i_image_height >> mgr->param.output_scale);
     assert(pic);
 
     memcpy(pic->head, &seqhead->head, sizeof(davs2_seq_info_t));
 
-    if (frame->i_type == AVS2_GB_SLICE) {
-        pic->frame = h->f_background_ref; ///!!! FIXME: actually NOT working (we do not support S frames now).
-    } else {
-        pic->frame = frame;
-    }
-
     frame->i_chroma_format    = h->i_chroma_format;
     frame->i_output_bit_depth = h->output_bit_depth;
     frame->i_sample_bit_depth = h->sample_bit_depth;
-    frame->frm_decode_error   = h->decoding_error;
+    frame->i_output_scale     = mgr->param.output_scale;
+    frame->frm_decode_error   = h->decoding_error || h->num_concealed_lcus > 0;
     h->decoding_error         = 0;  // clear decoding error status
 
+    if (h->num_concealed_lcus > 0) {
+        davs2_log(h, DAVS2_LOG_WARNING, "POC %3d: %d LCU(s) concealed", h->i_poc, h->num_concealed_lcus);
+    }
+
     pic->frame = frame;
 
     task_send_picture_to_output_list(h, pic);
 }
 
 /* ---------------------------------------------------------------------------
+ * start decoding the slice whose header has just been parsed
  */
-static ALWAYS_INLINE
-int check_slice_header(davs2_t *h, davs2_bs_t *bs, int lcu_y)
+static
+int slice_start_decoding(davs2_t *h, davs2_bs_t *bs, int lcu_y)
 {
     aec_t *p_aec = &h->aec;
 
+    h->i_slice_index++;
+
+    aec_init_contexts(p_aec);
+    aec_new_slice(h);
+    aec_start_decoding(p_aec, bs->p_stream, ((bs->i_bit_pos + 7) / 8), bs->i_stream);
+    AEC_RETURN_ON_ERROR(-1);
+
+    /* ǰSliceһеԤģʽ */
+    lcu_y <<= (h->i_lcu_level - MIN_PU_SIZE_IN_BIT);
+    memset(h->p_ipredmode + ((lcu_y - 1) & h->i_spu_row_mask) * h->i_ipredmode - 16, DC_PRED, h->i_ipredmode * sizeof(int8_t));
+
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static ALWAYS_INLINE
+int check_slice_header(davs2_t *h, davs2_bs_t *bs, int lcu_y)
+{
     if (h->b_slice_checked && found_slice_header(bs)) {
         /* slice starts at next byte */
         bs->i_bit_pos = (((bs->i_bit_pos + 7) >> 3) << 3);
-        h->i_slice_index++;
 
         parse_slice_header(h, bs);
-        aec_init_contexts(p_aec);
-        aec_new_slice(h);
-        aec_start_decoding(p_aec, bs->p_stream, ((bs->i_bit_pos + 7) / 8), bs->i_stream);
-        AEC_RETURN_ON_ERROR(-1);
-
-        /* ǰSliceһеԤģʽ */
-        lcu_y <<= (h->i_lcu_level - MIN_PU_SIZE_IN_BIT);
-        memset(h->p_ipredmode + (lcu_y - 1) * h->i_ipredmode - 16, DC_PRED, h->i_ipredmode * sizeof(int8_t));
+        return slice_start_decoding(h, bs, lcu_y);
     }
 
     return 0;
 }
 
+/* ---------------------------------------------------------------------------
+ * error concealment: the LCU lcu_xy is corrupted, the LCUs are concealed until
+ * the first LCU of the next slice found in the bitstream (whose header is
+ * parsed), where the decoding resumes. the rest of the picture is concealed
+ * if there is no such slice
+ */
+static
+void conceal_until_next_slice(davs2_t *h, davs2_bs_t *bs, int lcu_xy)
+{
+    const int num_lcus = h->i_width_in_lcu * h->i_height_in_lcu;
+    int pos;
+
+    h->decoding_error  = 1;
+    h->i_resync_lcu_xy = -1;
+
+    for (pos = (bs->i_bit_pos + 7) >> 3; pos + 4 <= bs->i_stream; pos++) {
+        const uint8_t *data = bs->p_stream + pos;
+
+        if (data[0] == 0 && data[1] == 0 && data[2] == 1 && data[3] <= SC_SLICE_CODE_MAX) {
+            int slice_lcu_xy;
+
+            bs->i_bit_pos = pos << 3;
+            slice_lcu_xy  = parse_slice_header(h, bs);
+            if (slice_lcu_xy > lcu_xy && slice_lcu_xy < num_lcus) {
+                h->i_resync_lcu_xy = slice_lcu_xy;
+                break;
+            }
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * intra modes and prediction directions are only kept for two LCU rows (the
+ * one being parsed and the one above it), reset the half of the rolling
+ * buffers that LCU row i_lcu_y is going to be parsed into
+ */
+static ALWAYS_INLINE
+void init_lcu_row_neighbors(davs2_t *h, int i_lcu_y)
+{
+    int i_shift = h->i_lcu_level - MIN_PU_SIZE_IN_BIT;
+    int row0    = (i_lcu_y << i_shift) & h->i_spu_row_mask;
+
+    memset(h->p_ipredmode + row0 * h->i_ipredmode - 16, DC_PRED, (h->i_ipredmode << i_shift) * sizeof(int8_t));
+    memset(h->p_dirpred + row0 * h->i_width_in_spu, PDIR_INVALID, (h->i_width_in_spu << i_shift) * sizeof(int8_t));
+}
+
 /* ---------------------------------------------------------------------------
  */
 static ALWAYS_INLINE
@@ -398,18 +458,36 @@ static int decode_one_lcu_row(davs2_t *h, davs2_bs_t *bs, int i_lcu_y)
 {
     const int height_in_lcu = h->i_height_in_lcu;
     const int width_in_lcu  = h->i_width_in_lcu;
-    int alf_enable          = h->pic_alf_on[0] | h->pic_alf_on[1] | h->pic_alf_on[2];
+    int alf_enable          = (h->pic_alf_on[0] | h->pic_alf_on[1] | h->pic_alf_on[2]) && !h->b_filters_off;
+    int b_sao               = h->b_sao && !h->b_filters_off;
+    int b_deblock           = h->b_loop_filter && !h->b_filters_off;
+    int b_conceal           = h->task_info.taskmgr->param.error_concealment;
     int lcu_xy              = i_lcu_y * width_in_lcu;
     int i_lcu_x;
     int i;
     davs2_row_rec_t row_rec;
 
+    init_lcu_row_neighbors(h, i_lcu_y);
+
     /* loop over all LCUs in current LCU row ------------------------
      */
-    for (i_lcu_x = 0; i_lcu_x < width_in_lcu && h->decoding_error == 0; i_lcu_x++, lcu_xy++) {
-        if (check_slice_header(h, bs, i_lcu_y) < 0) {
-            return -1;
+    for (i_lcu_x = 0; i_lcu_x < width_in_lcu && (h->decoding_error == 0 || b_conceal); i_lcu_x++, lcu_xy++) {
+        int b_lcu_concealed;
+
+        if (h->decoding_error != 0 && lcu_xy == h->i_resync_lcu_xy) {
+            /* error concealment: resume decoding with the slice found */
+            h->decoding_error  = 0;
+            h->b_slice_checked = 0;
+            if (slice_start_decoding(h, bs, i_lcu_y) < 0) {
+                conceal_until_next_slice(h, bs, lcu_xy);
+            }
+        } else if (h->decoding_error == 0 && check_slice_header(h, bs, i_lcu_y) < 0) {
+            if (!b_conceal) {
+                return -1;
+            }
+            conceal_until_next_slice(h, bs, lcu_xy);
         }
+        b_lcu_concealed = h->decoding_error != 0;
 
 #if AVS2_TRACE
         avs2_trace("\n*********** Pic: %i (I/P) MB: %i Slice: %i Type %d **********\n", h->i_poc, h->lcu.i_scu_xy, h->i_slice_index, h->i_frame_type);
@@ -417,35 +495,47 @@ static int decode_one_lcu_row(davs2_t *h, davs2_bs_t *bs, int i_lcu_y)
         h->lcu.lcu_aec = row_rec.lcu_info = &h->lcu_infos[lcu_xy];
 
         rowrec_lcu_init(h, &row_rec, i_lcu_x, i_lcu_y);
-        decode_lcu_init(h, i_lcu_x, i_lcu_y);
 
-        /* decode LCU level data before one LCU */
-        if (h->b_sao) {
-            sao_read_lcu_param(h, lcu_xy, h->slice_sao_on, &h->lcu.lcu_aec->sao_param);
+        /* cache CTU top border for intra prediction */
+        if (i_lcu_x == 0) {
+            memcpy(row_rec.ctu_border[0].rec_top + 1, h->intra_border[0], row_rec.ctu.i_ctu_w * 2 * sizeof(pel_t));
+            memcpy(row_rec.ctu_border[1].rec_top + 1, h->intra_border[1], row_rec.ctu.i_ctu_w * sizeof(pel_t));
+            memcpy(row_rec.ctu_border[2].rec_top + 1, h->intra_border[2], row_rec.ctu.i_ctu_w * sizeof(pel_t));
         }
 
-        if (h->b_alf) {
-            for (i = 0; i < IMG_COMPONENTS; i++) {
-                if (h->pic_alf_on[i]) {
-                    h->lcu.lcu_aec->enable_alf[i] = (uint8_t)aec_read_alf_lcu_ctrl(&h->aec);
-                } else {
-                    h->lcu.lcu_aec->enable_alf[i] = FALSE;
+        if (!b_lcu_concealed) {
+            decode_lcu_init(h, i_lcu_x, i_lcu_y);
+
+            /* decode LCU level data before one LCU */
+            if (h->b_sao) {
+                sao_read_lcu_param(h, lcu_xy, h->slice_sao_on, &h->lcu.lcu_aec->sao_param);
+            }
+
+            if (h->b_alf) {
+                for (i = 0; i < IMG_COMPONENTS; i++) {
+                    if (h->pic_alf_on[i]) {
+                        h->lcu.lcu_aec->enable_alf[i] = (uint8_t)aec_read_alf_lcu_ctrl(&h->aec);
+                    } else {
+                        h->lcu.lcu_aec->enable_alf[i] = FALSE;
+                    }
                 }
             }
-        }
 
-        /* decode one lcu */
-        decode_lcu_parse(h, h->i_lcu_level, h->lcu.i_pix_x, h->lcu.i_pix_y);
+            /* decode one lcu */
+            decode_lcu_parse(h, h->i_lcu_level, h->lcu.i_pix_x, h->lcu.i_pix_y);
 
-        /* cache CTU top border for intra prediction */
-        if (i_lcu_x == 0) {
-            memcpy(row_rec.ctu_border[0].rec_top + 1, h->intra_border[0], row_rec.ctu.i_ctu_w * 2 * sizeof(pel_t));
-            memcpy(row_rec.ctu_border[1].rec_top + 1, h->intra_border[1], row_rec.ctu.i_ctu_w * sizeof(pel_t));
-            memcpy(row_rec.ctu_border[2].rec_top + 1, h->intra_border[2], row_rec.ctu.i_ctu_w * sizeof(pel_t));
+            decode_lcu_recon(h, &row_rec, h->i_lcu_level, h->lcu.i_pix_x, h->lcu.i_pix_y);
+
+            if (h->decoding_error != 0 && b_conceal) {
+                conceal_until_next_slice(h, bs, lcu_xy);
+                b_lcu_concealed = 1;
+            }
+        }
+
+        if (b_lcu_concealed) {
+            decode_lcu_conceal(h, &row_rec, i_lcu_x, i_lcu_y);
         }
 
-        decode_lcu_recon(h, &row_rec, h->i_lcu_level, h->lcu.i_pix_x, h->lcu.i_pix_y);
-        
         rowrec_store_lcu_recon_samples(&row_rec);
         /* cache top and left samples for intra prediction of next CTU */
         davs2_cache_lcu_border(row_rec.ctu_border[0].rec_top, h->intra_border[0] + row_rec.ctu.i_pix_x + row_rec.ctu.i_ctu_w - 1,
@@ -462,22 +552,26 @@ static int decode_one_lcu_row(davs2_t *h, davs2_bs_t *bs, int i_lcu_y)
             memcpy(h->intra_border[2] + row_rec.ctu.i_pix_x_c, row_rec.ctu.p_frec[2] + (row_rec.ctu.i_ctu_h_c - 1) * h->fdec->i_stride[1], row_rec.ctu.i_ctu_w_c * sizeof(pel_t));
         }
 
+        if (b_lcu_concealed) {
+            continue;   /* neither parsed nor deblocked */
+        }
+
         /* decode LCU level data after one LCU
          * update the bit position */
         h->b_slice_checked = (bool_t)aec_startcode_follows(&h->aec, 1);
         bs->i_bit_pos      = aec_bits_read(&h->aec);
 
         /* deblock one lcu */
-        if (h->b_loop_filter) {
+        if (b_deblock) {
             davs2_lcu_deblock(h, h->fdec, i_lcu_x, i_lcu_y);
         }
     }
 
-    if (h->decoding_error != 0) {
+    if (h->decoding_error != 0 && !b_conceal) {
         
     } else {
         /* SAO current lcu-row */
-        if (h->b_sao) {
+        if (b_sao) {
             sao_lcurow(h, h->p_frame_sao, h->fdec, i_lcu_y);
         }
 
@@ -492,11 +586,8 @@ static int decode_one_lcu_row(davs2_t *h, davs2_bs_t *bs, int i_lcu_y)
         save_mv_ref_info(h, i_lcu_y);
     }
 
-    /* frame padding : line by line */
+    /* wake up all threads waiting for this reference row */
     if (h->rps.refered_by_others) {
-        pad_line_lcu(h, i_lcu_y);
-
-        /* wake up all waiting threads */
         decoder_signal(h, h->fdec, i_lcu_y);
     }
 
@@ -542,6 +633,8 @@ static int decode_one_lcu_row_parse(davs2_t *h, davs2_bs_t *bs, int i_lcu_y)
     int i_lcu_x;
     int i;
 
+    init_lcu_row_neighbors(h, i_lcu_y);
+
     /* loop over all LCUs in current LCU row ------------------------
      */
     for (i_lcu_x = 0; i_lcu_x < width_in_lcu; i_lcu_x++, lcu_xy++) {
@@ -597,7 +690,9 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
 {
     const int width_in_lcu  = h->i_width_in_lcu;
     const int height_in_lcu = h->i_height_in_lcu;
-    int alf_enable          = h->pic_alf_on[0] | h->pic_alf_on[1] | h->pic_alf_on[2];
+    int alf_enable          = (h->pic_alf_on[0] | h->pic_alf_on[1] | h->pic_alf_on[2]) && !h->b_filters_off;
+    int b_sao               = h->b_sao && !h->b_filters_off;
+    int b_deblock           = h->b_loop_filter && !h->b_filters_off;
     int i_lcu_level         = h->i_lcu_level;
     int lcu_xy              = i_lcu_y * h->i_width_in_lcu;
     int b_recon_finish      = 0;
@@ -647,7 +742,7 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
             }
 
             /* deblock one lcu */
-            if (h->b_loop_filter) {
+            if (b_deblock) {
                 davs2_lcu_deblock(h, h->fdec, i_lcu_x, i_lcu_y);
             }
 
@@ -656,7 +751,7 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
 
 
         /* SAO above lcu-row */
-        if (h->b_sao && i_lcu_y) {
+        if (b_sao && i_lcu_y) {
             sao_lcurow(h, h->p_frame_sao, h->fdec, i_lcu_y - 1);  // above row
 
             if (i_lcu_y == height_in_lcu - 1) {
@@ -673,10 +768,6 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
         }
 
         if (i_lcu_y > 0) {
-            /* frame padding : line by line */
-            if (h->rps.refered_by_others) {
-                pad_line_lcu(h, i_lcu_y - 1);
-            }
             /* wake up all waiting threads */
             decoder_signal(h, h->fdec, i_lcu_y - 1);
         }
@@ -695,10 +786,6 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
 
     /* the bottom LCU row in a frame */
     if (b_recon_finish) {
-        if (h->rps.refered_by_others) {
-            pad_line_lcu(h, h->i_height_in_lcu - 1);
-        }
-
         decoder_signal(h, h->fdec, h->i_height_in_lcu - 1);
         /* init for AVS-S */
         if ((h->i_frame_type == AVS2_P_SLICE || h->i_frame_type == AVS2_F_SLICE) && h->b_bkgnd_picture && h->b_bkgnd_reference) {
@@ -717,8 +804,8 @@ static int decode_lcu_row_recon(davs2_t *h, int i_lcu_y)
         }
 
         // davs2_log(h, DAVS2_LOG_INFO, "POC %3d reconstruction finished.", h->i_poc);
-        if (h->i_frame_type == AVS2_G_SLICE) {
-            davs2_frame_copy_planes(h->f_background_ref, h->fdec);
+        if (h->i_frame_type == AVS2_G_SLICE || h->i_frame_type == AVS2_GB_SLICE) {
+            task_update_background(h);
         }
 
         task_output_decoding_frame(h);
@@ -773,14 +860,9 @@ static void decode_user_data(davs2_t *h, davs2_bs_t *bs)
  */
 void decoder_free_extra_buffer(davs2_t *h)
 {
-    if (h->f_background_ref) {
-        davs2_frame_destroy(h->f_background_ref);
-        h->f_background_ref = NULL;
-    }
-
-    if (h->f_background_cur) {
-        davs2_frame_destroy(h->f_background_cur);
-        h->f_background_cur = NULL;
+    if (h->i_integral_size) {
+        davs2_mem_release(h->task_info.taskmgr, MEM_TASK_BUFFERS, h->i_integral_size);
+        h->i_integral_size = 0;
     }
 
     if (h->p_frame_alf) {
@@ -794,11 +876,44 @@ void decoder_free_extra_buffer(davs2_t *h)
     }
 
     if (h->p_integral) {
-        davs2_free(h->p_integral);
+        davs2_free_pages(h->p_integral);
         h->p_integral = NULL;
     }
 }
 
+/* ---------------------------------------------------------------------------
+ * size of the extra buffers of one decoder for the given sequence properties
+ */
+size_t decoder_get_extra_buffer_size(int width, int height, int lcu_level, int chroma_format, int b_alf, int b_sao)
+{
+    size_t w_in_spu = width  >> MIN_PU_SIZE_IN_BIT;
+    size_t h_in_spu = height >> MIN_PU_SIZE_IN_BIT;
+    size_t w_in_scu = width  >> MIN_CU_SIZE_IN_BIT;
+    size_t h_in_scu = height >> MIN_CU_SIZE_IN_BIT;
+    size_t size_in_spu = w_in_spu * h_in_spu;
+    size_t size_in_scu = w_in_scu * h_in_scu;
+    size_t rows_in_ring = (size_t)2 << (lcu_level - MIN_PU_SIZE_IN_BIT);
+    int    w_in_lcu = (width  + (1 << lcu_level) - 1) >> lcu_level;
+    int    h_in_lcu = (height + (1 << lcu_level) - 1) >> lcu_level;
+    size_t size_in_lcu = (size_t)w_in_lcu * h_in_lcu;
+    size_t size_alf = alf_get_buffer_size(w_in_lcu, h_in_lcu);
+    size_t size_extra_frame = (b_alf + b_sao) * davs2_frame_get_size(width, height, chroma_format, 0);
+
+    return sizeof(int8_t)     * (w_in_spu + 16) * rows_in_ring   + /* M1, size of intra prediction mode buffer (two LCU rows) */
+           sizeof(int8_t)     * w_in_spu * rows_in_ring          + /* M2, size of prediction direction buffer (two LCU rows) */
+           sizeof(ref_idx_t)  * size_in_spu                      + /* M3, size of reference index (1st+2nd) buffer */
+           sizeof(mv_t)       * size_in_spu                      + /* M5, size of motion vector of 4x4 block (1st reference) buffer */
+           sizeof(mv_t)       * size_in_spu                      + /* M6, size of motion vector of 4x4 block (2nd reference) buffer */
+           sizeof(uint8_t)    * w_in_scu * h_in_scu * 2          + /* M7, size of loop filter flag buffer */
+           sizeof(lcu_info_t) * size_in_lcu                      + /* M8, size of SAO block parameter buffer */
+           sizeof(scu_t)      * size_in_scu                      + /* M9, size of scu_t */
+           sizeof(cu_t)       * size_in_scu                      + /* M10, size of cu_t */
+           sizeof(pel_t)      * width * 3                        + /* M13, size of last LCU row bottom border */
+           size_alf                                              + /* M11, size of ALF */
+           size_extra_frame                                      + /* M12, size of extra frame */
+           CACHE_LINE_SIZE * 20;
+}
+
 /* ---------------------------------------------------------------------------
  * alloc extra buffers for the decoder according to the image width & height
  */
@@ -809,45 +924,44 @@ int decoder_alloc_extra_buffer(davs2_t *h)
     size_t w_in_scu = h->i_width_in_scu;
     size_t h_in_scu = h->i_height_in_scu;
     size_t size_in_spu = w_in_spu * h_in_spu;
+    size_t rows_in_ring = (size_t)2 << (h->i_lcu_level - MIN_PU_SIZE_IN_BIT);
     size_t size_in_lcu = ((h->i_width + h->i_lcu_size_sub1) >> h->i_lcu_level) * ((h->i_height + h->i_lcu_size_sub1) >> h->i_lcu_level);
-    size_t size_alf = alf_get_buffer_size(h);
-    size_t size_extra_frame = 0;
+    size_t size_alf = alf_get_buffer_size(h->i_width_in_lcu, h->i_height_in_lcu);
     size_t mem_size;
 
     uint8_t *mem_base;
 
     assert((h->i_width  & 7) == 0);
     assert((h->i_height & 7) == 0);
-    size_extra_frame = 2 * davs2_frame_get_size(h->i_width, h->i_height, h->i_chroma_format, 1);
-    size_extra_frame += (h->b_alf + h->b_sao) * davs2_frame_get_size(h->i_width, h->i_height, h->i_chroma_format, 0);
-
-    mem_size = sizeof(int8_t)     * (w_in_spu + 16) * (h_in_spu + 1) + /* M1, size of intra prediction mode buffer */
-               sizeof(int8_t)     * size_in_spu                      + /* M3, size of prediction direction buffer */
-               sizeof(ref_idx_t)  * size_in_spu                      + /* M3, size of reference index (1st+2nd) buffer */
-               sizeof(mv_t)       * size_in_spu                      + /* M5, size of motion vector of 4x4 block (1st reference) buffer */
-               sizeof(mv_t)       * size_in_spu                      + /* M6, size of motion vector of 4x4 block (2nd reference) buffer */
-               sizeof(uint8_t)    * w_in_scu * h_in_scu * 2          + /* M7, size of loop filter flag buffer */
-               sizeof(lcu_info_t) * size_in_lcu                      + /* M8, size of SAO block parameter buffer */
-               sizeof(cu_t)       * h->i_size_in_scu                 + /* M10, size of cu_t */
-               sizeof(pel_t)      * h->i_width * 3                   + /* M13, size of last LCU row bottom border */
-               size_alf                                              + /* M11, size of ALF */
-               size_extra_frame                                      + /* M12, size of extra frame */
-               CACHE_LINE_SIZE * 20;
 
-    /* allocate memory for a decoder */
-    CHECKED_MALLOC(mem_base, uint8_t *, mem_size);
+    mem_size = decoder_get_extra_buffer_size(h->i_width, h->i_height, h->i_lcu_level, h->i_chroma_format, h->b_alf, h->b_sao);
+
+    if (davs2_mem_charge(h->task_info.taskmgr, MEM_TASK_BUFFERS, mem_size, 1) < 0) {
+        davs2_log(h, DAVS2_LOG_ERROR, "memory budget exceeded, failed to allocate %llu bytes of task buffers\n",
+                  (unsigned long long)mem_size);
+        return -1;
+    }
+    h->i_integral_size = mem_size;
+
+    /* allocate memory for a decoder, placed by the memory policy of the decoder */
+    mem_base = (uint8_t *)davs2_malloc_pages(mem_size, h->task_info.taskmgr->b_huge_pages,
+                                             h->task_info.taskmgr->i_numa_node);
+    if (mem_base == NULL) {
+        goto fail;
+    }
     h->p_integral = mem_base;   /* pointer which holds the extra buffer */
 
     /* M1, intra prediction mode buffer */
     h->p_ipredmode  = (int8_t *)mem_base;
-    mem_base       += sizeof(int8_t) * (w_in_spu + 16) * (h_in_spu + 1);
-    h->p_ipredmode += (w_in_spu + 16) + 16;
+    mem_base       += sizeof(int8_t) * (w_in_spu + 16) * rows_in_ring;
+    h->p_ipredmode += 16;
     h->i_ipredmode  = ((int)w_in_spu + 16);
+    h->i_spu_row_mask = (int)rows_in_ring - 1;
     ALIGN_POINTER(mem_base);
 
-    /* M3, prediction direction buffer */
+    /* M2, prediction direction buffer */
     h->p_dirpred = (int8_t *)mem_base;
-    mem_base += sizeof(int8_t) * size_in_spu;
+    mem_base += sizeof(int8_t) * w_in_spu * rows_in_ring;
     ALIGN_POINTER(mem_base);
 
     /* M3, reference index (1st) buffer */
@@ -877,8 +991,13 @@ int decoder_alloc_extra_buffer(davs2_t *h)
     mem_base       += sizeof(lcu_info_t) * size_in_lcu;
     ALIGN_POINTER(mem_base);
 
-    /* allocate memory for scu_data */
-    h->scu_data     = (cu_t *)mem_base;
+    /* M9, neighboring info of each SCU */
+    h->scu_data     = (scu_t *)mem_base;
+    mem_base       += h->i_size_in_scu * sizeof(scu_t);
+    ALIGN_POINTER(mem_base);
+
+    /* M10, CU info (at the top-left SCU of each CU) */
+    h->cu_data      = (cu_t *)mem_base;
     mem_base       += h->i_size_in_scu * sizeof(cu_t);
     ALIGN_POINTER(mem_base);
 
@@ -900,23 +1019,18 @@ int decoder_alloc_extra_buffer(davs2_t *h)
     alf_init_buffer(h);
 
     /* -------------------------------------------------------------
-     * allocate frame buffers */
-
-    // AVS-S
-    h->f_background_ref = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 1);
-    ALIGN_POINTER(mem_base);
-    h->f_background_cur = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 1);
-    ALIGN_POINTER(mem_base);
+     * allocate frame buffers
+     * (AVS2-S background frames are shared by all tasks, see task_update_background()) */
 
     // ALF
     if (h->b_alf) {
-        h->p_frame_alf = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 0);
+        h->p_frame_alf = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 0, NULL);
         ALIGN_POINTER(mem_base);
     }
 
     // SAO
     if (h->b_sao) {
-        h->p_frame_sao = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 0);
+        h->p_frame_sao = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, &mem_base, 0, NULL);
         ALIGN_POINTER(mem_base);
     }
 
@@ -934,6 +1048,41 @@ fail:
     return -1;
 }
 
+/* ---------------------------------------------------------------------------
+ * copy one plane to the output picture with 1/2 (scale = 1) or 1/4 (scale = 2)
+ * downscaling, fused with the conversion to the output bit depth
+ */
+static void write_plane_downscaled(uint8_t *p_dst, int i_dst, pel_t *p_src, int i_src, int width, int height,
+                                   int scale, int shift, int num_bytes_per_sample)
+{
+    if (!shift && sizeof(pel_t) == num_bytes_per_sample) {
+        gf_davs2.plane_downscale[scale - 1]((pel_t *)p_dst, i_dst / sizeof(pel_t), p_src, i_src, width, height);
+    } else {
+        /* 8-bit output */
+        const int size    = 1 << scale;
+        const int shift_s = 2 * scale + shift;
+        int j, k, x, y;
+
+        for (j = 0; j < height; j++) {
+            for (k = 0; k < width; k++) {
+                const pel_t *s = p_src + k * size;
+                int sum = 0;
+
+                for (y = 0; y < size; y++) {
+                    for (x = 0; x < size; x++) {
+                        sum += s[x];
+                    }
+                    s += i_src;
+                }
+                p_dst[k] = (uint8_t)DAVS2_MIN((sum + (1 << (shift_s - 1))) >> shift_s, 255);
+            }
+
+            p_src += i_src << scale;
+            p_dst += i_dst;
+        }
+    }
+}
+
 /* ---------------------------------------------------------------------------
  * write a frame to output picture
  */
@@ -958,7 +1107,18 @@ void davs2_write_a_frame(davs2_picture_t *pic, davs2_frame_t *frame)
     pic->strides[1] = pic->widths[1] * num_bytes_per_sample;
     pic->strides[2] = pic->widths[2] * num_bytes_per_sample;
 
-    if (!shift1 && sizeof(pel_t) == num_bytes_per_sample) {
+    if (frame->i_output_scale > 0) {
+        /* reduced-resolution output, the decoded frame keeps the full resolution */
+        write_plane_downscaled(pic->planes[0], pic->strides[0], frame->planes[0], frame->i_stride[0],
+                               img_width, img_height, frame->i_output_scale, shift1, num_bytes_per_sample);
+
+        if (pic->num_planes == 3) {
+            write_plane_downscaled(pic->planes[1], pic->strides[1], frame->planes[1], frame->i_stride[1],
+                                   img_width_c, img_height_c, frame->i_output_scale, shift1, num_bytes_per_sample);
+            write_plane_downscaled(pic->planes[2], pic->strides[2], frame->planes[2], frame->i_stride[2],
+                                   img_width_c, img_height_c, frame->i_output_scale, shift1, num_bytes_per_sample);
+        }
+    } else if (!shift1 && sizeof(pel_t) == num_bytes_per_sample) {
         pic->dec_frame = frame;
         // TODO: ¸ֵǰָҪʵʱ򣨽֧ʱָ
         pic->planes[0]  = frame->planes[0];
@@ -1116,8 +1276,13 @@ void *decoder_decode_picture_data(void *arg1, int arg2)
     /* user data and slice header */
     decode_user_data(h, bs);
 
+    /* error concealment: no slice found, the whole picture is concealed */
+    if (h->b_slice_checked == 0 && h->task_info.taskmgr->param.error_concealment) {
+        h->decoding_error = 1;
+    }
+
     /* decode picture data */
-    if (h->b_slice_checked != 0) {
+    if (h->b_slice_checked != 0 || h->decoding_error != 0) {
         davs2_frame_t *frame = h->fref[0];
         davs2_mgr_t *mgr = h->task_info.taskmgr;
         const int height_in_lcu = h->i_height_in_lcu;
@@ -1179,8 +1344,8 @@ void *decoder_decode_picture_data(void *arg1, int arg2)
             }
         }
 
-        if (h->i_frame_type == AVS2_G_SLICE) {
-            davs2_frame_copy_planes(h->f_background_ref, h->fdec);
+        if (h->i_frame_type == AVS2_G_SLICE || h->i_frame_type == AVS2_GB_SLICE) {
+            task_update_background(h);
         }
 
         /* task is free */
@@ -48,6 +48,8 @@ void decoder_close(davs2_t *h);
 int  create_freepictures(davs2_mgr_t *mgr, int w, int h, int size);
 #define destroy_freepictures FPFX(destroy_freepictures)
 void destroy_freepictures(davs2_mgr_t *mgr);
+#define decoder_get_extra_buffer_size FPFX(decoder_get_extra_buffer_size)
+size_t decoder_get_extra_buffer_size(int width, int height, int lcu_level, int chroma_format, int b_alf, int b_sao);
 #define decoder_alloc_extra_buffer FPFX(decoder_alloc_extra_buffer)
 int  decoder_alloc_extra_buffer(davs2_t *h);
 #define decoder_free_extra_buffer FPFX(decoder_free_extra_buffer)
@@ -57,6 +59,8 @@ void davs2_write_a_frame(davs2_picture_t *pic, davs2_frame_t *frame);
 
 #define task_get_references FPFX(task_get_references)
 int  task_get_references(davs2_t *h, int64_t pts, int64_t dts);
+#define task_skip_picture FPFX(task_skip_picture)
+void task_skip_picture(davs2_t *h);
 
 #define task_unload_packet FPFX(task_unload_packet)
 void task_unload_packet(davs2_t *h, es_unit_t *es_unit);
@@ -218,12 +218,15 @@ enum intra_chroma_pred_mode_e {
  * max value */
 #define AVS2_THREAD_MAX        16     /* max number of threads */
 #define DAVS2_WORK_MAX        128     /* max number of works (thread queue) */
+#define GROUP_MAX_CACHED_FRAMES 32    /* max number of released frames kept by a decoder group */
 #define AVS2_MAX_REFS           4     /* max reference frame number */
+#define AVS2_MAX_HELD_FRAMES   16     /* max number of output frames held by the application (zero-copy output) */
 #define AVS2_GOP_NUM           32     /* max GOP number */
 #define AVS2_COI_CYCLE        256     /* COI ranges from [0, 255] */
 
 #define MAX_POC_DISTANCE      128     /* max POC distance */
 #define INVALID_FRAME          -1     /* invalid value for COI & POC */
+#define MAX_SKIPPED_POC       256     /* window of POCs of skipped pictures not yet passed by the output */
 
 #define CG_SIZE                16     /* size of an coefficient group, 4x4 */
 
@@ -233,7 +236,7 @@ enum intra_chroma_pred_mode_e {
 #define MAX_ES_FRAME_SIZE 4000000     /* default max es frame size: 4MB */
 #define MAX_ES_FRAME_NUM       64     /* default number of es frames */
 
-#define AVS2_PAD        (64 + 16)     /* number of pixels padded around the reference frame */
+#define AVS2_PAD        32            /* number of pixels around the frame planes (SIMD over-reads, ALF), MC emulates the edges */
 
 #define DAVS2_MAX_LCU_ROWS   256      /* maximum number of LCU rows of one frame */ 
 
@@ -88,57 +88,6 @@ void pad_line_pixel(pel_t *pix, int width, int num_pad)
 #endif
 }
 
-/* ---------------------------------------------------------------------------
- */
-void pad_line_lcu(davs2_t *h, int lcu_y)
-{
-    davs2_frame_t *frame = h->fdec;
-    int i, j;
-
-    for (i = 0; i < 3; i++) {
-        int chroma_shift = !!i;
-        int start = ((lcu_y + 0) << h->i_lcu_level) >> chroma_shift; ///< -4 for ALF
-        int end   = ((lcu_y + 1) << h->i_lcu_level) >> chroma_shift;
-        int i_stride = frame->i_stride[i];
-        int i_width  = frame->i_width[i];
-        const int num_pad = AVS2_PAD >> chroma_shift;
-        pel_t *pix;
-
-        if (lcu_y > 0) {
-            start -= 4;
-        }
-        if (lcu_y < h->i_height_in_lcu - 1) {
-            end -= 4;
-        }
-
-        /* padding these rows */
-        for (j = start; j < end; j++) {
-            pix = frame->planes[i] + j * i_stride;
-            pad_line_pixel(pix, i_width, num_pad);
-        }
-
-        /* for the first row, padding the rows above the picture edges */
-        if (lcu_y == 0) {
-            pix = frame->planes[i] - (num_pad);
-
-            for (j = 0; j < (num_pad); j++) {
-                gf_davs2.memcpy_aligned(pix - i_stride, pix, i_stride * sizeof(pel_t));
-                pix -= i_stride;
-            }
-        }
-
-        /* for the last row, padding the rows under of the picture edges */
-        if (lcu_y == h->i_height_in_lcu - 1) {
-            pix = frame->planes[i] + (frame->i_lines[i] - 1) * i_stride - (num_pad);
-
-            for (j = 0; j < (num_pad); j++) {
-                gf_davs2.memcpy_aligned(pix + i_stride, pix, i_stride * sizeof(pel_t));
-                pix += i_stride;
-            }
-        }
-    }
-}
-
 /**
  * ===========================================================================
  * memory handling
@@ -206,14 +155,14 @@ size_t davs2_frame_get_size(int width, int height, int chroma_format, int b_extr
                sizeof(mv_t)   * extra_buf_size              + /* M3, size of SPU motion vector buffer */
                sizeof(davs2_thread_cond_t) * max_lcu_height + /* M4, condition variables for each LCU line */
                sizeof(int) * max_lcu_height                 + /* M5, LCU decoding status */
-               CACHE_LINE_SIZE * 6;
+               CACHE_LINE_SIZE * 8;
 
     return mem_size;
 }
 
 /* ---------------------------------------------------------------------------
  */
-davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t **mem_base, int b_extra)
+davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t **mem_base, int b_extra, davs2_mgr_t *mgr)
 {
     const int width_c        = width >> 1;
     const int height_c       = height >> (chroma_format == CHROMA_420 ? 1 : 0);
@@ -226,7 +175,7 @@ davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t
     int stride_l, stride_c;
     int size_l, size_c;         /* size of luma and chroma plane */
     int i, mem_size;            /* total memory size */
-    davs2_frame_t *frame;
+    davs2_frame_t *frame = NULL;
     uint8_t *mem_ptr;
 
     /* need extra buffer? */
@@ -252,7 +201,12 @@ davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t
                CACHE_LINE_SIZE * 8;
 
     if (mem_base == NULL) {
-        CHECKED_MALLOC(mem_ptr, uint8_t *, mem_size);
+        /* own buffer, placed by the memory policy of the decoder */
+        mem_ptr = (uint8_t *)davs2_malloc_pages(mem_size, mgr != NULL ? mgr->b_huge_pages : 0,
+                                                mgr != NULL ? mgr->i_numa_node : -1);
+        if (mem_ptr == NULL) {
+            goto fail;
+        }
     } else {
         mem_ptr = *mem_base;
     }
@@ -320,8 +274,14 @@ davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t
     if (mem_base != NULL) {
         *mem_base = mem_ptr;
         frame->is_self_malloc = 0;
+        frame->i_mem_size     = 0;
+        frame->b_huge_pages   = 0;
+        frame->i_numa_node    = -1;
     } else {
         frame->is_self_malloc = 1;
+        frame->i_mem_size     = mem_size;
+        frame->b_huge_pages   = mgr != NULL ? mgr->b_huge_pages : 0;
+        frame->i_numa_node    = mgr != NULL ? mgr->i_numa_node : -1;
     }
 
     frame->i_conds         = max_lcu_height;
@@ -342,8 +302,8 @@ davs2_frame_t *davs2_frame_new(int width, int height, int chroma_format, uint8_t
     return frame;
 
 fail:
-    if (mem_ptr) {
-        davs2_free(mem_ptr);
+    if (mem_base == NULL && frame != NULL) {
+        davs2_free_pages(frame);
     }
 
     return NULL;
@@ -368,7 +328,7 @@ void davs2_frame_destroy(davs2_frame_t *frame)
 
     /* free the frame itself */
     if (frame->is_self_malloc) {
-        davs2_free(frame);
+        davs2_free_pages(frame);
     }
 }
 
@@ -90,6 +90,8 @@ enum extension_id_e {
 
 #define ROI_DATA_FILE   "roi.dat"     // ROI location data output
 
+#define DPB_TRIM_INTERVAL   64        // number of pictures between two checks for unused DPB frames
+
 static bool_t open_dbp_buffer_warning = 1;
 
 /**
@@ -681,6 +683,74 @@ static int parse_picture_header_inter(davs2_t *h, davs2_bs_t *bs)
     return 0;
 }
 
+/* ---------------------------------------------------------------------------
+ * read an inter picture header up to random_access_decodable_flag (same
+ * syntax as parse_picture_header_inter()), return the flag
+ */
+static int peek_random_access_decodable(const davs2_seq_t *seq, davs2_bs_t *bs)
+{
+    int pic_struct;
+    int background_pred_flag = 0;
+    int pic_coding_type = FRAME;
+    int i, num;
+
+    bs->i_bit_pos += 32;                /* start code */
+    u_v(bs, 32, "bbv delay");
+    pic_struct = u_v(bs, 2, "picture_coding_type");
+    if (seq->enable_background_picture && (pic_struct == 1 || pic_struct == 3)) {
+        if (pic_struct == 1) {
+            background_pred_flag = u_v(bs, 1, "background_pred_flag");
+        }
+        if (background_pred_flag == 0) {
+            u_v(bs, 1, "background_reference_enable");
+        }
+    }
+
+    u_v(bs, 8, "coding_order");
+    if (seq->b_temporal_id_exist == 1) {
+        u_v(bs, TEMPORAL_MAXLEVEL_BIT, "temporal_id");
+    }
+    if (seq->head.low_delay == 0) {
+        ue_v(bs, "displaydelay");
+    }
+
+    if (u_v(bs, 1, "use RPS in SPS")) {
+        u_v(bs, 5, "predict for RPS");
+    } else {
+        u_v(bs, 1, "refered by others");
+        num = u_v(bs, 3, "num of reference picture");
+        for (i = 0; i < num; i++) {
+            u_v(bs, 6, "delta COI of ref pic");
+        }
+        num = u_v(bs, 3, "num of removed picture");
+        for (i = 0; i < num; i++) {
+            u_v(bs, 6, "delta COI of removed pic");
+        }
+        u_v(bs, 1, "marker bit");
+    }
+
+    if (seq->head.low_delay) {
+        ue_v(bs, "bbv check times");
+    }
+
+    if (!u_v(bs, 1, "progressive_frame")) {
+        pic_coding_type = u_v(bs, 1, "picture_structure");
+    }
+    u_v(bs, 1, "top_field_first");
+    u_v(bs, 1, "repeat_first_field");
+    if (seq->b_field_coding) {
+        u_v(bs, 1, "is_top_field");
+        u_v(bs, 1, "reserved bit for interlace coding");
+    }
+    u_v(bs, 1, "fixed_picture_qp");
+    u_v(bs, 7, "picture_qp");
+    if (!(pic_struct == 2 && pic_coding_type == FRAME)) {
+        u_v(bs, 1, "reserved_bit");
+    }
+
+    return u_flag(bs, "random_access_decodable_flag");
+}
+
 /* ---------------------------------------------------------------------------
  */
 static
@@ -754,13 +824,14 @@ int parse_picture_header(davs2_t *h, davs2_bs_t *bs, uint32_t start_code)
  */
 
 /* ---------------------------------------------------------------------------
+ * returns the index (in raster scan) of the first LCU of the slice
  */
-void parse_slice_header(davs2_t *h, davs2_bs_t *bs)
+int parse_slice_header(davs2_t *h, davs2_bs_t *bs)
 {
     int slice_vertical_position;
     int slice_vertical_position_extension = 0;
     int slice_horizontal_positon;
-    int slice_horizontal_positon_extension;
+    int slice_horizontal_positon_extension = 0;
     int mb_row;
 
     /* skip start code: 00 00 01 */
@@ -803,22 +874,32 @@ void parse_slice_header(davs2_t *h, davs2_bs_t *bs)
         h->slice_sao_on[1] = u_flag(bs, "sao_slice_flag_Cb");
         h->slice_sao_on[2] = u_flag(bs, "sao_slice_flag_Cr");
     }
+
+    return mb_row * h->i_width_in_lcu + (slice_horizontal_positon_extension << 8) + slice_horizontal_positon;
 }
 
 /* ---------------------------------------------------------------------------
  */
-davs2_outpic_t *alloc_picture(int w, int h)
+static INLINE size_t picture_get_size(int w, int h)
+{
+    return sizeof(davs2_outpic_t) + sizeof(davs2_seq_info_t) + sizeof(davs2_picture_t) + sizeof(pel_t) * w * h * 3 / 2;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+davs2_outpic_t *alloc_picture(davs2_mgr_t *mgr, int w, int h)
 {
     davs2_outpic_t *pic = NULL;
     uint8_t *buf;
 
-    buf = (uint8_t *)davs2_malloc(sizeof(davs2_outpic_t)     +
-                                   sizeof(davs2_seq_info_t) +
-                                   sizeof(davs2_picture_t)  + sizeof(pel_t) * w * h * 3 / 2);
+    buf = (uint8_t *)davs2_malloc(picture_get_size(w, h));
     if (buf == NULL) {
         return NULL;
     }
 
+    /* output pictures are not limited by the budget, their number is bounded by the application */
+    davs2_mem_charge(mgr, MEM_OUTPUT, picture_get_size(w, h), 0);
+
     pic = (davs2_outpic_t *)buf;
 
     buf += sizeof(davs2_outpic_t); /* davs2_outpic_t */
@@ -849,13 +930,103 @@ davs2_outpic_t *alloc_picture(int w, int h)
 
 /* ---------------------------------------------------------------------------
  */
-void free_picture(davs2_outpic_t *pic)
+void free_picture(davs2_mgr_t *mgr, davs2_outpic_t *pic)
 {
     if (pic) {
+        davs2_mem_release(mgr, MEM_OUTPUT, picture_get_size(pic->pic->widths[0], pic->pic->lines[0]));
         davs2_free(pic);
     }
 }
 
+/* ---------------------------------------------------------------------------
+ * replace the background reference frame, which is held by one reference
+ * count of the manager (mutex_mgr should be locked by the caller)
+ */
+static void background_set_reference(davs2_mgr_t *mgr, davs2_frame_t *frame)
+{
+    davs2_frame_t *old_frame = mgr->f_background_ref;
+
+    if (frame != NULL) {
+        davs2_thread_mutex_lock(&frame->mutex_frm);
+        frame->i_ref_count++;
+        davs2_thread_mutex_unlock(&frame->mutex_frm);
+    }
+
+    mgr->f_background_ref = frame;
+
+    if (old_frame != NULL && old_frame->i_disposable == 2) {
+        /* a GB picture (not in the DPB) is no longer held by the manager */
+        davs2_mem_release(mgr, MEM_FRAMES, old_frame->i_mem_size);
+    }
+    release_one_frame(old_frame);
+}
+
+/* ---------------------------------------------------------------------------
+ * free a DPB frame which is no longer referenced. in a decoder group, the
+ * frame is kept for reuse by the decoders of the same resolution and memory
+ * placement (the oldest one is freed when the cache is full)
+ */
+static void dpb_free_frame(davs2_mgr_t *mgr, davs2_frame_t *frame)
+{
+    davs2_group_t *group = mgr->group;
+
+    if (group != NULL) {
+        davs2_frame_t *oldest = NULL;
+
+        clean_one_frame(frame);
+
+        davs2_thread_mutex_lock(&group->mutex);
+        if (group->num_cached_frames == GROUP_MAX_CACHED_FRAMES) {
+            oldest = group->cached_frames[0];
+            memmove(group->cached_frames, group->cached_frames + 1,
+                    (GROUP_MAX_CACHED_FRAMES - 1) * sizeof(davs2_frame_t *));
+            group->num_cached_frames--;
+        }
+        group->cached_frames[group->num_cached_frames++] = frame;
+        davs2_thread_mutex_unlock(&group->mutex);
+
+        frame = oldest;
+    }
+
+    if (frame != NULL) {
+        davs2_frame_destroy(frame);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * take a frame of the given resolution released by a decoder in the group.
+ * the frame must have been placed with the huge-page and NUMA settings of
+ * this decoder, so that a shared cache does not defeat them
+ */
+static davs2_frame_t *dpb_reuse_frame(davs2_mgr_t *mgr, int width, int height, int chroma_format)
+{
+    davs2_group_t *group    = mgr->group;
+    davs2_frame_t *frame    = NULL;
+    const int      height_c = height >> (chroma_format == CHROMA_420 ? 1 : 0);
+    int i;
+
+    if (group == NULL) {
+        return NULL;
+    }
+
+    davs2_thread_mutex_lock(&group->mutex);
+    for (i = group->num_cached_frames - 1; i >= 0; i--) {
+        davs2_frame_t *cached = group->cached_frames[i];
+
+        if (cached->i_width[0] == width && cached->i_lines[0] == height && cached->i_lines[1] == height_c &&
+            cached->b_huge_pages == mgr->b_huge_pages && cached->i_numa_node == mgr->i_numa_node) {
+            frame = cached;
+            group->num_cached_frames--;
+            memmove(group->cached_frames + i, group->cached_frames + i + 1,
+                    (group->num_cached_frames - i) * sizeof(davs2_frame_t *));
+            break;
+        }
+    }
+    davs2_thread_mutex_unlock(&group->mutex);
+
+    return frame;
+}
+
 /* ---------------------------------------------------------------------------
  * destroy decoding picture buffer(DPB)
  */
@@ -864,17 +1035,23 @@ void destroy_dpb(davs2_mgr_t *mgr)
     davs2_frame_t *frame = NULL;
     int i;
 
+    /* background frames may refer to a frame in the DPB */
+    background_set_reference(mgr, NULL);
+
     for (i = 0; i < mgr->dpbsize; i++) {
         frame = mgr->dpb[i];
-        assert(frame);
+        if (frame == NULL) {
+            continue;   /* never allocated */
+        }
 
         mgr->dpb[i] = NULL;
+        davs2_mem_release(mgr, MEM_FRAMES, frame->i_mem_size);
 
         davs2_thread_mutex_lock(&frame->mutex_frm);
 
         if (frame->i_ref_count == 0) {
             davs2_thread_mutex_unlock(&frame->mutex_frm);
-            davs2_frame_destroy(frame);
+            dpb_free_frame(mgr, frame);
         } else {
             frame->i_disposable = 2; /* free when not referenced */
             davs2_thread_mutex_unlock(&frame->mutex_frm);
@@ -883,46 +1060,178 @@ void destroy_dpb(davs2_mgr_t *mgr)
 
     davs2_free(mgr->dpb);
     mgr->dpb = NULL;
+    mgr->dpbsize = 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * empty the DPB (davs2_decoder_reset()), the frames are kept for the following
+ * pictures. no picture is under decoding, a frame may only be held by an
+ * output picture (mutex_mgr should be locked by the caller)
+ */
+void dpb_reset(davs2_mgr_t *mgr)
+{
+    int i;
+
+    background_set_reference(mgr, NULL);
+
+    for (i = 0; i < mgr->dpbsize; i++) {
+        davs2_frame_t *frame = mgr->dpb[i];
+
+        if (frame != NULL) {
+            davs2_thread_mutex_lock(&frame->mutex_frm);
+            clean_one_frame(frame);
+            davs2_thread_mutex_unlock(&frame->mutex_frm);
+        }
+    }
+
+    mgr->num_frames_to_remove = 0;
 }
 
 /* ---------------------------------------------------------------------------
  * create decoding picture buffer(DPB)
+ * the size is the max number of frames alive at the same time, frames are
+ * allocated on first use (see dpb_get_free_frame())
  */
 static INLINE
 int create_dpb(davs2_mgr_t *mgr)
 {
     davs2_seq_t *seq = &mgr->seq_info;
-    uint8_t      *mem_ptr = NULL;
-    size_t        mem_size = 0;
+    int num_kept = 0;   /* frames kept for reference */
     int i;
 
-    mgr->dpbsize = mgr->num_decoders + seq->picture_reorder_delay + 16;  /// !!! FIXME: decide dpb buffer size ?
-    mgr->dpbsize += 8;  // FIXME: Ҫ
+    if (seq->num_of_rps > 0) {
+        for (i = 0; i < seq->num_of_rps; i++) {
+            /* frames to be removed are still alive until the next picture */
+            num_kept = DAVS2_MAX(num_kept, seq->seq_rps[i].num_of_ref + seq->seq_rps[i].num_to_remove);
+        }
+    } else {
+        num_kept = AVS2_MAX_REFS;
+    }
 
-    mem_size = mgr->dpbsize * sizeof(davs2_frame_t *)
-        + davs2_frame_get_size(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, 1) * mgr->dpbsize
-        + davs2_frame_get_size(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, 0)
-        + CACHE_LINE_SIZE * (mgr->dpbsize + 2);
+    mgr->dpbsize = num_kept                       /* reference frames */
+                 + seq->picture_reorder_delay     /* frames waiting for output */
+                 + mgr->num_decoders              /* frames under decoding */
+                 + AVS2_MAX_REFS                  /* RPS in picture headers */
+                 + AVS2_MAX_HELD_FRAMES;          /* output frames not released by the application yet */
 
-    mem_ptr = (uint8_t *)davs2_malloc(mem_size);
-    if (mem_ptr == NULL) {
-        return -1;
+    mgr->dpb_trim_count = 0;
+    mgr->dpb_min_idle   = mgr->dpbsize;
+    CHECKED_MALLOCZERO(mgr->dpb, davs2_frame_t **, mgr->dpbsize * sizeof(davs2_frame_t *));
+
+    return 0;
+
+fail:
+    mgr->dpbsize = 0;
+    return -1;
+}
+
+/* ---------------------------------------------------------------------------
+ * release the frames that have been idle during the last DPB_TRIM_INTERVAL
+ * pictures (one spare frame is kept), so that the DPB shrinks back to what
+ * the stream needs in steady state
+ */
+static void dpb_trim(davs2_mgr_t *mgr, int num_idle)
+{
+    int i;
+
+    mgr->dpb_min_idle = DAVS2_MIN(mgr->dpb_min_idle, num_idle);
+
+    if (++mgr->dpb_trim_count < DPB_TRIM_INTERVAL) {
+        return;
+    }
+
+    for (i = 0; i < mgr->dpbsize && mgr->dpb_min_idle > 1; i++) {
+        davs2_frame_t *frame = mgr->dpb[i];
+        int b_idle;
+
+        if (frame == NULL) {
+            continue;
+        }
+
+        davs2_thread_mutex_lock(&frame->mutex_frm);
+        b_idle = frame->i_ref_count == 0 && frame->b_refered_by_others == 0;
+        davs2_thread_mutex_unlock(&frame->mutex_frm);
+
+        if (b_idle) {
+            mgr->dpb[i] = NULL;
+            davs2_mem_release(mgr, MEM_FRAMES, frame->i_mem_size);
+            dpb_free_frame(mgr, frame);
+            mgr->dpb_min_idle--;
+        }
     }
 
-    mgr->dpb = (davs2_frame_t **)mem_ptr;
-    mem_ptr += mgr->dpbsize * sizeof(davs2_frame_t *);
-    ALIGN_POINTER(mem_ptr);
+    mgr->dpb_trim_count = 0;
+    mgr->dpb_min_idle   = mgr->dpbsize;
+}
+
+/* ---------------------------------------------------------------------------
+ * get a free frame from the DPB for reconstruction (mutex_mgr should be
+ * locked by the caller), a new frame is allocated if none of the allocated
+ * frames is free. returns NULL if the DPB is full or the memory budget does
+ * not allow another frame
+ */
+static davs2_frame_t *dpb_get_free_frame(davs2_mgr_t *mgr, int b_refered_by_others)
+{
+    davs2_seq_t   *seq      = &mgr->seq_info;
+    davs2_frame_t *fdec     = NULL;
+    int            idx_new  = -1;
+    int            num_idle = 0;
+    int i;
 
     for (i = 0; i < mgr->dpbsize; i++) {
-        mgr->dpb[i] = davs2_frame_new(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, &mem_ptr, 1);
-        ALIGN_POINTER(mem_ptr);
+        davs2_frame_t *frame = mgr->dpb[i];
 
-        if (mgr->dpb[i] == NULL) {
-            return -1;
+        if (frame == NULL) {
+            idx_new = idx_new < 0 ? i : idx_new;
+            continue;
+        }
+
+        davs2_thread_mutex_lock(&frame->mutex_frm);
+
+        if (frame->i_ref_count == 0 && frame->b_refered_by_others == 0) {
+            if (fdec == NULL) {
+                assert(frame->i_disposable == 0);
+
+                frame->i_ref_count++;   /* for the decoding thread */
+                frame->i_ref_count++;   /* for the output thread */
+
+                frame->i_disposable = b_refered_by_others == 0 ? 1 : 0;
+
+                fdec = frame;
+            } else {
+                num_idle++;
+            }
         }
+
+        davs2_thread_mutex_unlock(&frame->mutex_frm);
     }
 
-    return 0;
+    if (fdec == NULL && idx_new >= 0) {
+        /* grow the DPB */
+        size_t size_frame = davs2_frame_get_size(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, 1);
+
+        if (davs2_mem_charge(mgr, MEM_FRAMES, size_frame, 1) == 0) {
+            fdec = dpb_reuse_frame(mgr, seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format);
+            if (fdec == NULL) {
+                fdec = davs2_frame_new(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, NULL, 1, mgr);
+            }
+
+            if (fdec != NULL) {
+                assert(fdec->i_mem_size == size_frame);
+                fdec->i_ref_count  = 2;     /* for the decoding thread and the output thread */
+                fdec->i_disposable = b_refered_by_others == 0 ? 1 : 0;
+                mgr->dpb[idx_new]  = fdec;
+            } else {
+                davs2_mem_release(mgr, MEM_FRAMES, size_frame);
+            }
+        }
+    }
+
+    if (fdec != NULL) {
+        dpb_trim(mgr, num_idle);
+    }
+
+    return fdec;
 }
 
 /* ---------------------------------------------------------------------------
@@ -1062,6 +1371,68 @@ int task_decoder_update(davs2_t *h)
     return 0;
 }
 
+/* ---------------------------------------------------------------------------
+ * fit the decoder into the memory budget for the current sequence (mutex_mgr
+ * should be locked by the caller): besides the frames kept for reference and
+ * reordering, every frame decoded in parallel needs one more frame and the
+ * buffers of its task, so the number of usable tasks is reduced accordingly.
+ * returns -1 if not even one task fits in the budget
+ */
+static int task_apply_memory_budget(davs2_mgr_t *mgr)
+{
+    davs2_seq_t *seq    = &mgr->seq_info;
+    int64_t      budget = mgr->param.max_memory;
+    int64_t size_frame; /* one DPB frame */
+    int64_t size_task;  /* buffers of one task */
+    int64_t size_fixed; /* memory needed whatever the number of tasks */
+    int num_tasks;
+    int i;
+
+    mgr->num_usable_decoders = mgr->num_decoders;
+
+    if (budget <= 0) {
+        return 0;
+    }
+
+    size_frame = davs2_frame_get_size(seq->i_enc_width, seq->i_enc_height, seq->head.chroma_format, 1);
+    size_task  = decoder_get_extra_buffer_size(seq->i_enc_width, seq->i_enc_height, seq->log2_lcu_size,
+                                               seq->head.chroma_format, seq->enable_alf, seq->enable_sao);
+
+    davs2_thread_mutex_lock(&mgr->mutex_mem);
+    size_fixed = mgr->mem_used[MEM_CONTEXT] + mgr->mem_used[MEM_BITSTREAM];
+    davs2_thread_mutex_unlock(&mgr->mutex_mem);
+
+    /* reference, reordering and background frames (see create_dpb()), one output picture */
+    size_fixed += (mgr->dpbsize - mgr->num_decoders - AVS2_MAX_REFS - AVS2_MAX_HELD_FRAMES) * size_frame;
+    size_fixed += picture_get_size(seq->head.width >> mgr->param.output_scale, seq->head.height >> mgr->param.output_scale);
+
+    if (budget - size_fixed < size_task + size_frame) {
+        davs2_log(mgr, DAVS2_LOG_ERROR, "memory budget of %lld bytes is too small for %dx%d, at least %lld bytes are needed.",
+                  (long long)budget, seq->head.width, seq->head.height, (long long)(size_fixed + size_task + size_frame));
+        return -1;
+    }
+
+    num_tasks = (int)DAVS2_MIN((int)((budget - size_fixed) / (size_task + size_frame)), mgr->num_decoders);
+
+    if (num_tasks < mgr->num_decoders) {
+        davs2_log(mgr, DAVS2_LOG_INFO, "memory budget of %lld bytes: %d of %d tasks used.",
+                  (long long)budget, num_tasks, mgr->num_decoders);
+    }
+
+    mgr->num_usable_decoders = num_tasks;
+
+    /* idle tasks beyond the limit give their buffers back now, busy ones when they finish */
+    for (i = num_tasks; i < mgr->num_decoders; i++) {
+        davs2_t *h = &mgr->decoders[i];
+
+        if (h->task_info.task_status == TASK_FREE) {
+            decoder_free_extra_buffer(h);
+        }
+    }
+
+    return 0;
+}
+
 /* ---------------------------------------------------------------------------
  */
 static
@@ -1097,6 +1468,10 @@ int task_set_sequence_head(davs2_mgr_t *mgr, davs2_seq_t *seq)
                 ret = -1;
                 memset(&mgr->seq_info, 0, sizeof(davs2_seq_t));
                 davs2_log(mgr, DAVS2_LOG_ERROR, "failed to create dpb buffers. %dx%d.", seq->head.width, seq->head.height);
+            } else if (task_apply_memory_budget(mgr) < 0) {
+                ret = -1;
+                destroy_dpb(mgr);
+                memset(&mgr->seq_info, 0, sizeof(davs2_seq_t));
             }
             mgr->new_sps = TRUE;
         }
@@ -1170,6 +1545,24 @@ void task_release_frames(davs2_t *h)
     h->fdec = NULL;
 }
 
+/* ---------------------------------------------------------------------------
+ * AVS2-S: the decoded GB picture becomes the background reference. The
+ * frame is shared by reference instead of copying its planes. a G picture
+ * stays an ordinary DPB frame and only drops the previous background: no
+ * prediction reads the background frame yet, so the DPB has no slot for
+ * pinning a G picture
+ */
+void task_update_background(davs2_t *h)
+{
+    davs2_mgr_t *mgr = h->task_info.taskmgr;
+
+    davs2_thread_mutex_lock(&mgr->mutex_mgr);
+
+    background_set_reference(mgr, h->i_frame_type == AVS2_GB_SLICE ? h->fdec : NULL);
+
+    davs2_thread_mutex_unlock(&mgr->mutex_mgr);
+}
+
 /* ---------------------------------------------------------------------------
  */
 int has_blocking(davs2_mgr_t *mgr)
@@ -1181,6 +1574,11 @@ int has_blocking(davs2_mgr_t *mgr)
     int decodingframes = 0, outputframes = 0;
     int i;
 
+    /* the expected frame is skipped, the output thread will move on */
+    if (pics->skipped[pics->output % MAX_SKIPPED_POC] == pics->output) {
+        return 0;
+    }
+
     /* is the expected frame already in the output list ? */
     for (pic = pics->pics; pic; pic = pic->next) {
         frame = pic->frame;
@@ -1227,25 +1625,17 @@ int has_blocking(davs2_mgr_t *mgr)
     return 1;
 }
 
+#define IS_VALID_FRAME(frame) ((frame) != NULL && (frame)->i_coi != INVALID_FRAME && (frame)->i_poc != INVALID_FRAME)
+
 /* ---------------------------------------------------------------------------
+ * remove the frames listed by the RPS of the previous picture from the DPB
  */
-int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
+static void dpb_remove_frames(davs2_mgr_t *mgr)
 {
-    davs2_mgr_t    *mgr   = h->task_info.taskmgr;
     davs2_frame_t **dpb   = mgr->dpb;
     davs2_frame_t  *frame = NULL;
     int i, j;
 
-#define IS_VALID_FRAME(frame) ((frame)->i_coi != INVALID_FRAME && (frame)->i_poc != INVALID_FRAME)
-
-    davs2_thread_mutex_lock(&mgr->mutex_mgr);
-
-    h->fdec = NULL;
-    h->num_of_references = 0;
-    for (i = 0; i < AVS2_MAX_REFS; i++) {
-        h->fref[i] = NULL;
-    }
-
     for (i = 0; i < mgr->num_frames_to_remove; i++) {
         int coi_frame_to_remove = mgr->coi_remove_frame[i];
 
@@ -1274,10 +1664,47 @@ int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
             davs2_thread_mutex_unlock(&frame->mutex_frm);
         }
     }
+}
+
+/* ---------------------------------------------------------------------------
+ */
+int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
+{
+    davs2_mgr_t    *mgr   = h->task_info.taskmgr;
+    davs2_frame_t **dpb   = mgr->dpb;
+    davs2_frame_t  *frame = NULL;
+    int i, j;
 
+    davs2_thread_mutex_lock(&mgr->mutex_mgr);
+
+    h->fdec = NULL;
+    h->num_of_references = 0;
+    for (i = 0; i < AVS2_MAX_REFS; i++) {
+        h->fref[i] = NULL;
+    }
+
+    dpb_remove_frames(mgr);
 
     if (h->i_frame_type == AVS2_GB_SLICE) {
-        h->fdec = h->f_background_cur;
+        /* GB picture: reconstructed into a frame of its own (outside of the
+         * DPB), since GB pictures of several tasks may be decoded at once.
+         * the memory is released when the frame stops being the background
+         * reference (see background_set_reference()) */
+        size_t size_frame = davs2_frame_get_size(h->i_width, h->i_height, h->i_chroma_format, 1);
+
+        if (davs2_mem_charge(mgr, MEM_FRAMES, size_frame, 1) < 0) {
+            davs2_log(h, DAVS2_LOG_ERROR, "memory budget exceeded, failed to allocate the background frame.");
+            goto fail;
+        }
+        frame = davs2_frame_new(h->i_width, h->i_height, h->i_chroma_format, NULL, 1, mgr);
+        if (frame == NULL) {
+            davs2_mem_release(mgr, MEM_FRAMES, size_frame);
+            davs2_log(h, DAVS2_LOG_ERROR, "failed to allocate the background frame.");
+            goto fail;
+        }
+        frame->i_ref_count  = 2;    /* for the decoding thread and the output thread */
+        frame->i_disposable = 2;    /* free when not referenced */
+        h->fdec = frame;
     } else {
         for (i = 0; i < h->rps.num_of_ref; i++) {
             int ref_frame_coi = h->i_coi - h->rps.ref_pic[i];
@@ -1359,28 +1786,7 @@ int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
 
         /* find fdec */
         for (;;) {
-            for (i = 0; i < mgr->dpbsize; i++) {
-                frame = dpb[i];
-
-                davs2_thread_mutex_lock(&frame->mutex_frm);
-
-                if (frame->i_ref_count == 0 && frame->b_refered_by_others == 0) {
-                    assert(frame->i_disposable == 0);
-
-                    frame->i_ref_count++;   /* for the decoding thread */
-                    frame->i_ref_count++;   /* for the output thread */
-
-                    frame->i_disposable = h->rps.refered_by_others == 0 ? 1 : 0;
-
-                    h->fdec = frame;
-
-                    davs2_thread_mutex_unlock(&frame->mutex_frm);
-
-                    break;
-                }
-
-                davs2_thread_mutex_unlock(&frame->mutex_frm);
-            }
+            h->fdec = dpb_get_free_frame(mgr, h->rps.refered_by_others);
 
             if (h->fdec != NULL) {
                 /* got it */
@@ -1400,9 +1806,14 @@ int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
                     /* find the frame with the least POC value */
                     for (i = 0; i < mgr->dpbsize; i++) {
                         frame = dpb[i];
+                        if (frame == NULL) {
+                            continue;
+                        }
                         davs2_thread_mutex_lock(&frame->mutex_frm);
 
-                        if (frame->i_ref_count == 0 && (h->fdec == NULL || h->fdec->i_poc > frame->i_poc)) {
+                        /* a frame still in the RPS must not be overwritten */
+                        if (frame->i_ref_count == 0 && frame->b_refered_by_others == 0 &&
+                            (h->fdec == NULL || h->fdec->i_poc > frame->i_poc)) {
                             if (h->fdec) {
                                 davs2_thread_mutex_lock(&h->fdec->mutex_frm);
                                 h->fdec->i_ref_count--;
@@ -1454,6 +1865,9 @@ int task_get_references(davs2_t *h, int64_t pts, int64_t dts)
             int num_in_spu = h->i_width_in_spu * h->i_height_in_spu;
 
             for (i = 0; i < mgr->dpbsize; i++) {
+                if (dpb[i] == NULL) {
+                    continue;
+                }
                 memset(dpb[i]->mvbuf, 0, num_in_spu * sizeof(mv_t));
                 memset(dpb[i]->refbuf, 0, num_in_spu * sizeof(int8_t));
             }
@@ -1474,6 +1888,41 @@ fail:
     return -1;
 }
 
+/* ---------------------------------------------------------------------------
+ * a picture is not decoded (davs2_param_t::skip_frame): the DPB is updated as
+ * its RPS says and its POC is marked so that the output does not wait for it
+ */
+void task_skip_picture(davs2_t *h)
+{
+    davs2_mgr_t    *mgr  = h->task_info.taskmgr;
+    davs2_output_t *pics = &mgr->outpics;
+    int i;
+
+    davs2_thread_mutex_lock(&mgr->mutex_mgr);
+
+    dpb_remove_frames(mgr);
+
+    if (h->i_frame_type != AVS2_GB_SLICE) {
+        mgr->num_frames_to_remove = h->rps.num_to_remove;
+
+        for (i = 0; i < h->rps.num_to_remove; i++) {
+            mgr->coi_remove_frame[i] = h->i_coi - h->rps.remove_pic[i];
+        }
+    }
+
+    if (pics->output != INVALID_FRAME && h->i_poc >= pics->output) {
+        pics->skipped[h->i_poc % MAX_SKIPPED_POC] = h->i_poc;
+
+        /* move on when the next frame to output is skipped */
+        while (pics->skipped[pics->output % MAX_SKIPPED_POC] == pics->output) {
+            pics->skipped[pics->output % MAX_SKIPPED_POC] = INVALID_FRAME;
+            pics->output++;
+        }
+    }
+
+    davs2_thread_mutex_unlock(&mgr->mutex_mgr);
+}
+
 /* ---------------------------------------------------------------------------
  */
 int parse_header(davs2_t *h, davs2_bs_t *p_bs)
@@ -1542,3 +1991,62 @@ int parse_header(davs2_t *h, davs2_bs_t *p_bs)
 
     return 1;
 }
+
+/* ---------------------------------------------------------------------------
+ * find the points where a bitstream could be split into segments decodable
+ * independently: a sequence header followed by an I picture, where the inter
+ * pictures before the next I picture (or the end of the bitstream) are all
+ * random access decodable, i.e. none of them refers to the previous segment.
+ * returns the number of points (byte offsets of the sequence headers)
+ */
+int find_random_access_points(const uint8_t *data, int len, int *offsets, int max_offsets)
+{
+    davs2_seq_t seq;
+    int b_seq_valid = 0;
+    int candidate   = -1;   /* sequence header not followed by a picture yet */
+    int pending     = -1;   /* point being verified by the following inter pictures */
+    int num_points  = 0;
+    int pos         = 0;
+    const uint8_t *p_start_code;
+
+    while (pos + 4 <= len && (p_start_code = find_start_code(data + pos, len - pos)) != NULL) {
+        davs2_bs_t bs;
+
+        pos = (int)(p_start_code - data);
+        if (pos + 4 > len) {
+            break;
+        }
+        bs_init(&bs, (uint8_t *)data + pos, len - pos);
+
+        switch (data[pos + 3]) {
+        case SC_SEQUENCE_HEADER:
+            b_seq_valid = parse_sequence_header(NULL, &seq, &bs) == 0;
+            candidate   = b_seq_valid ? pos : -1;
+            break;
+        case SC_INTRA_PICTURE:
+            /* the previous point is verified until this I picture */
+            if (pending >= 0 && num_points < max_offsets) {
+                offsets[num_points++] = pending;
+            }
+            pending   = candidate;
+            candidate = -1;
+            break;
+        case SC_INTER_PICTURE:
+            candidate = -1;
+            if (pending >= 0 && (!b_seq_valid || !peek_random_access_decodable(&seq, &bs))) {
+                pending = -1;   /* open GOP: refers to the previous segment */
+            }
+            break;
+        default:
+            break;
+        }
+
+        pos += 4;
+    }
+
+    if (pending >= 0 && num_points < max_offsets) {
+        offsets[num_points++] = pending;
+    }
+
+    return num_points;
+}
@@ -2650,11 +2650,15 @@ void davs2_intra_pred_init(uint32_t cpuid, ao_funcs_t *pf)
         ipred[INTRA_ANG_XY_16] = intra_pred_ang_xy_16_sse128;
         ipred[INTRA_ANG_XY_18] = intra_pred_ang_xy_18_sse128;
         ipred[INTRA_ANG_XY_20] = intra_pred_ang_xy_20_sse128;
+        ipred[INTRA_ANG_XY_15] = intra_pred_ang_xy_sse128;
+        ipred[INTRA_ANG_XY_17] = intra_pred_ang_xy_sse128;
+        ipred[INTRA_ANG_XY_19] = intra_pred_ang_xy_sse128;
+        ipred[INTRA_ANG_XY_21] = intra_pred_ang_xy_sse128;
 
         ipred[INTRA_ANG_X_5  ] = intra_pred_ang_x_5_sse128;
-        //ipred[INTRA_ANG_X_7  ] = intra_pred_ang_x_7_sse128;
-        //ipred[INTRA_ANG_X_9  ] = intra_pred_ang_x_9_sse128;
-        //ipred[INTRA_ANG_X_11 ] = intra_pred_ang_x_11_sse128;
+        ipred[INTRA_ANG_X_7  ] = intra_pred_ang_x_7_sse128;
+        ipred[INTRA_ANG_X_9  ] = intra_pred_ang_x_9_sse128;
+        ipred[INTRA_ANG_X_11 ] = intra_pred_ang_x_11_sse128;
 
         ipred[INTRA_ANG_XY_13] = intra_pred_ang_xy_13_sse128;
         ipred[INTRA_ANG_XY_22] = intra_pred_ang_xy_22_sse128;
@@ -2662,7 +2666,9 @@ void davs2_intra_pred_init(uint32_t cpuid, ao_funcs_t *pf)
 
         ipred[INTRA_ANG_Y_25 ] = intra_pred_ang_y_25_sse128;
         ipred[INTRA_ANG_Y_26 ] = intra_pred_ang_y_26_sse128;
+        ipred[INTRA_ANG_Y_27 ] = intra_pred_ang_y_27_sse128;
         ipred[INTRA_ANG_Y_28 ] = intra_pred_ang_y_28_sse128;
+        ipred[INTRA_ANG_Y_29 ] = intra_pred_ang_y_29_sse128;
         ipred[INTRA_ANG_Y_30 ] = intra_pred_ang_y_30_sse128;
         ipred[INTRA_ANG_Y_31 ] = intra_pred_ang_y_31_sse128;
         ipred[INTRA_ANG_Y_32 ] = intra_pred_ang_y_32_sse128;
@@ -2688,25 +2694,29 @@ void davs2_intra_pred_init(uint32_t cpuid, ao_funcs_t *pf)
         ipred[INTRA_ANG_X_4  ] = intra_pred_ang_x_4_avx;
         ipred[INTRA_ANG_X_5  ] = intra_pred_ang_x_5_avx;
         ipred[INTRA_ANG_X_6  ] = intra_pred_ang_x_6_avx;
-        //ipred[INTRA_ANG_X_7  ] = intra_pred_ang_x_7_avx;
+        ipred[INTRA_ANG_X_7  ] = intra_pred_ang_x_7_avx;
         ipred[INTRA_ANG_X_8  ] = intra_pred_ang_x_8_avx;
-        //ipred[INTRA_ANG_X_9  ] = intra_pred_ang_x_9_avx;
+        ipred[INTRA_ANG_X_9  ] = intra_pred_ang_x_9_avx;
         ipred[INTRA_ANG_X_10 ] = intra_pred_ang_x_10_avx;
-        //ipred[INTRA_ANG_X_11 ] = intra_pred_ang_x_11_avx;
+        ipred[INTRA_ANG_X_11 ] = intra_pred_ang_x_11_avx;
 
         ipred[INTRA_ANG_XY_13] = intra_pred_ang_xy_13_avx;
         ipred[INTRA_ANG_XY_14] = intra_pred_ang_xy_14_avx;
         ipred[INTRA_ANG_XY_16] = intra_pred_ang_xy_16_avx;
         ipred[INTRA_ANG_XY_18] = intra_pred_ang_xy_18_avx;
         ipred[INTRA_ANG_XY_20] = intra_pred_ang_xy_20_avx;
-#if _MSC_VER  // TODO: 20180206 cause unextended exit on Linux
         ipred[INTRA_ANG_XY_22] = intra_pred_ang_xy_22_avx;
-#endif
         ipred[INTRA_ANG_XY_23] = intra_pred_ang_xy_23_avx;
+        ipred[INTRA_ANG_XY_15] = intra_pred_ang_xy_avx;
+        ipred[INTRA_ANG_XY_17] = intra_pred_ang_xy_avx;
+        ipred[INTRA_ANG_XY_19] = intra_pred_ang_xy_avx;
+        ipred[INTRA_ANG_XY_21] = intra_pred_ang_xy_avx;
 
         ipred[INTRA_ANG_Y_25 ] = intra_pred_ang_y_25_avx;
         ipred[INTRA_ANG_Y_26 ] = intra_pred_ang_y_26_avx;
+        ipred[INTRA_ANG_Y_27 ] = intra_pred_ang_y_27_avx;
         ipred[INTRA_ANG_Y_28 ] = intra_pred_ang_y_28_avx;
+        ipred[INTRA_ANG_Y_29 ] = intra_pred_ang_y_29_avx;
         ipred[INTRA_ANG_Y_30 ] = intra_pred_ang_y_30_avx;
         ipred[INTRA_ANG_Y_31 ] = intra_pred_ang_y_31_avx;
         ipred[INTRA_ANG_Y_32 ] = intra_pred_ang_y_32_avx;
@@ -491,6 +491,44 @@ static void interp_hv_pp_##width##x##height##_c(const pel_t* src, intptr_t srcSt
 //INTPL_OP_C(4, 8)
 //INTPL_OP_C(4, 4)  /* 4x4 */
 
+/* ---------------------------------------------------------------------------
+ * edge emulation: reference pictures are not padded, so a block whose
+ * interpolation window reaches outside of the picture is built in a local
+ * buffer with the picture edges replicated
+ */
+#define MC_EMU_MARGIN   4                       /* taps of the interpolation filters outside of the block */
+#define MC_EMU_STRIDE   (MAX_CU_SIZE + 32)      /* room for SIMD over-reads */
+#define MC_EMU_LINES    (MAX_CU_SIZE + 16)
+
+/* ---------------------------------------------------------------------------
+ * returns NULL if the window is inside of the picture, otherwise the position
+ * of the block in the emulated buffer (with stride MC_EMU_STRIDE)
+ */
+static pel_t *mc_emulate_edge(pel_t *buf, const pel_t *p_fref, int i_fref, int posx, int posy, int width, int height, int pic_w, int pic_h)
+{
+    const int x0 = posx - MC_EMU_MARGIN;
+    const int y0 = posy - MC_EMU_MARGIN;
+    const int w  = width  + 2 * MC_EMU_MARGIN;
+    const int h  = height + 2 * MC_EMU_MARGIN;
+    pel_t *dst = buf;
+    int i, j;
+
+    if (x0 >= 0 && y0 >= 0 && x0 + w <= pic_w && y0 + h <= pic_h) {
+        return NULL;
+    }
+
+    for (i = 0; i < h; i++) {
+        const pel_t *src = p_fref + DAVS2_CLIP3(0, pic_h - 1, y0 + i) * i_fref;
+
+        for (j = 0; j < w; j++) {
+            dst[j] = src[DAVS2_CLIP3(0, pic_w - 1, x0 + j)];
+        }
+        dst += MC_EMU_STRIDE;
+    }
+
+    return buf + MC_EMU_MARGIN * MC_EMU_STRIDE + MC_EMU_MARGIN;
+}
+
 /* ---------------------------------------------------------------------------
  * interpolation of 1/4 subpixel
  *      A  dst  1  src  B
@@ -504,14 +542,19 @@ void mc_luma(davs2_t *h, pel_t *dst, int i_dst, int posx, int posy, int width, i
     const int dx = posx & 3;
     const int dy = posy & 3;
     const int mc_part_index = MC_PART_INDEX(width, height);
+    ALIGN32(pel_t emu_buf[MC_EMU_STRIDE * MC_EMU_LINES]);
+    pel_t *p_emu;
 
-
-    UNUSED_PARAMETER(h);
     posx >>= 2;
     posy >>= 2;
-    
 
-    p_fref += posy * i_fref + posx;
+    p_emu = mc_emulate_edge(emu_buf, p_fref, i_fref, posx, posy, width, height, h->i_width, h->i_height);
+    if (p_emu != NULL) {
+        p_fref = p_emu;
+        i_fref = MC_EMU_STRIDE;
+    } else {
+        p_fref += posy * i_fref + posx;
+    }
     
     if (dx == 0 && dy == 0) {
         gf_davs2.copy_pp[PART_INDEX(width, height)](dst, i_dst, p_fref, i_fref);
@@ -539,12 +582,21 @@ void mc_chroma(davs2_t *h, pel_t *dst, int i_dst, int posx, int posy, int width,
     const int dx = posx & 7;
     const int dy = posy & 7;
     const int mc_part_index = MC_PART_INDEX(width, height);
+    const int pic_w = h->i_width >> 1;
+    const int pic_h = h->i_height >> (h->i_chroma_format == CHROMA_420 ? 1 : 0);
+    ALIGN32(pel_t emu_buf[MC_EMU_STRIDE * MC_EMU_LINES]);
+    pel_t *p_emu;
 
-    UNUSED_PARAMETER(h);
     posx >>= 3;
     posy >>= 3;
 
-    p_fref += posy * i_fref + posx;
+    p_emu = mc_emulate_edge(emu_buf, p_fref, i_fref, posx, posy, width, height, pic_w, pic_h);
+    if (p_emu != NULL) {
+        p_fref = p_emu;
+        i_fref = MC_EMU_STRIDE;
+    } else {
+        p_fref += posy * i_fref + posx;
+    }
 
     if (dx == 0 && dy == 0) {
         if (width != 2 && width != 6 && height != 2 && height != 6) {
@@ -594,6 +646,50 @@ static void davs2_pixel_average_c(pel_t *dst, int i_dst, const pel_t *src0, int
  */
 #define plane_copy_c          mc_block_copy_c
 
+/* ---------------------------------------------------------------------------
+ * 1/2 downscaling of a plane, average of 2x2 pixels
+ */
+static void
+plane_downscale_half_c(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h)
+{
+    int i, j;
+
+    for (i = 0; i < h; i++) {
+        const pel_t *s0 = src;
+        const pel_t *s1 = src + i_src;
+
+        for (j = 0; j < w; j++) {
+            dst[j] = (pel_t)((s0[2 * j] + s0[2 * j + 1] + s1[2 * j] + s1[2 * j + 1] + 2) >> 2);
+        }
+        dst += i_dst;
+        src += 2 * i_src;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 1/4 downscaling of a plane, average of 4x4 pixels
+ */
+static void
+plane_downscale_quarter_c(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h)
+{
+    int i, j, k;
+
+    for (i = 0; i < h; i++) {
+        for (j = 0; j < w; j++) {
+            const pel_t *s = src + 4 * j;
+            int sum = 0;
+
+            for (k = 0; k < 4; k++) {
+                sum += s[0] + s[1] + s[2] + s[3];
+                s   += i_src;
+            }
+            dst[j] = (pel_t)((sum + 8) >> 4);
+        }
+        dst += i_dst;
+        src += 4 * i_src;
+    }
+}
+
 #define ALL_LUMA_PU(name1, name2, cpu) \
     pf->name1[PART_64x64] = name2 ## _64x64 ##_## cpu;  /* 64x64 */ \
     pf->name1[PART_64x32] = name2 ## _64x32 ##_## cpu;\
@@ -639,6 +735,10 @@ void davs2_mc_init(uint32_t cpuid, ao_funcs_t *pf)
     pf->block_copy       = mc_block_copy_c;
     pf->block_coeff_copy = mc_block_copy_sc_c;
 
+    /* output downscaling */
+    pf->plane_downscale[0] = plane_downscale_half_c;
+    pf->plane_downscale[1] = plane_downscale_quarter_c;
+
     /* block average */
     pf->block_avg        = davs2_pixel_average_c;
 
@@ -700,6 +800,10 @@ void davs2_mc_init(uint32_t cpuid, ao_funcs_t *pf)
         pf->block_avg        = avs_pixel_average_sse128;
 
 #if !HIGH_BIT_DEPTH
+        /* output downscaling */
+        pf->plane_downscale[0] = plane_downscale_half_sse128;
+        pf->plane_downscale[1] = plane_downscale_quarter_sse128;
+
         /* interpolate */
         pf->intpl_luma_hor[0][0] = intpl_luma_block_hor_sse128;
         pf->intpl_luma_hor[0][1] = intpl_luma_block_hor_sse128;
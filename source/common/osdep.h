@@ -358,6 +358,23 @@ int davs2_threading_init(void);
 #define davs2_sleep_ms(x)              usleep(x * 1000)
 #endif
 
+/* atomic compare-and-swap of an int, true if *p was old_val and is now new_val */
+#if defined(_MSC_VER)
+#define davs2_atomic_cas(p, old_val, new_val) \
+    (InterlockedCompareExchange((volatile LONG *)(p), (LONG)(new_val), (LONG)(old_val)) == (LONG)(old_val))
+#else
+#define davs2_atomic_cas(p, old_val, new_val) __sync_bool_compare_and_swap((p), (old_val), (new_val))
+#endif
+
+/* atomic load with acquire and store with release semantics of an int */
+#if defined(_MSC_VER)
+#define davs2_atomic_load_acquire(p)     InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define davs2_atomic_store_release(p, v) InterlockedExchange((volatile LONG *)(p), (LONG)(v))
+#else
+#define davs2_atomic_load_acquire(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define davs2_atomic_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
 
 /**
  * ===========================================================================
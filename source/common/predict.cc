@@ -508,7 +508,7 @@ static void fill_mv_bskip(davs2_t *h, cu_t *p_cu, int pix_x, int pix_y, int size
         p_mv_1st  = h->p_tmv_1st + offset_spu;
         p_mv_2nd  = h->p_tmv_2nd + offset_spu;
         p_ref_1st = h->p_ref_idx + offset_spu;
-        p_dirpred = h->p_dirpred + offset_spu;
+        p_dirpred = h->p_dirpred + (j8_1st & h->i_spu_row_mask) * width_in_spu + i8_1st;
         i_dir_pred = (int8_t)p_cu->b8pdir[0];
 
         switch (ds_mode) {
@@ -567,7 +567,7 @@ static void fill_mv_bskip(davs2_t *h, cu_t *p_cu, int pix_x, int pix_y, int size
             p_mv_1st  = h->p_tmv_1st + offset_spu;
             p_mv_2nd  = h->p_tmv_2nd + offset_spu;
             p_ref_1st = h->p_ref_idx + offset_spu;
-            p_dirpred  = h->p_dirpred + offset_spu;
+            p_dirpred  = h->p_dirpred + (j8 & h->i_spu_row_mask) * width_in_spu + i8;
 
             if (refframe == -1) {
                 get_mvp_default(h, p_cu, pix_x, pix_y, &mv_1st, 0, 0, size_cu, 0);
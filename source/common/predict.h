@@ -253,7 +253,7 @@ void cu_get_neighbor_spatial(davs2_t *h, int cur_slice_idx, neighbor_inter_t *p_
         const int w_in_4x4 = h->i_width_in_spu;
         const int pos = y4 * w_in_4x4 + x4;
         p_neighbor->is_available = 1;
-        p_neighbor->i_dir_pred = h->p_dirpred[pos];
+        p_neighbor->i_dir_pred = h->p_dirpred[(y4 & h->i_spu_row_mask) * w_in_4x4 + x4];
         p_neighbor->ref_idx = h->p_ref_idx[pos];
         p_neighbor->mv[0] = h->p_tmv_1st[pos];
         p_neighbor->mv[1] = h->p_tmv_2nd[pos];
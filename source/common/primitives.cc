@@ -46,6 +46,21 @@
  */
 ao_funcs_t gf_davs2 = {0};
 
+/* ---------------------------------------------------------------------------
+ */
+void init_primitives(uint32_t cpuid, ao_funcs_t *pf)
+{
+    davs2_memory_init    (cpuid, pf);
+    davs2_intra_pred_init(cpuid, pf);
+    davs2_pixel_init     (cpuid, pf);
+    davs2_mc_init        (cpuid, pf);
+    davs2_quant_init     (cpuid, pf);
+    davs2_dct_init       (cpuid, pf);
+    davs2_deblock_init   (cpuid, pf);
+    davs2_sao_init       (cpuid, pf);
+    davs2_alf_init       (cpuid, pf);
+}
+
 /* ---------------------------------------------------------------------------
  */
 void init_all_primitives(uint32_t cpuid)
@@ -60,14 +75,5 @@ void init_all_primitives(uint32_t cpuid)
     gf_davs2.cpuid         = cpuid;
 
     /* init function handles */
-    davs2_memory_init    (cpuid, &gf_davs2);
-    davs2_intra_pred_init(cpuid, &gf_davs2);
-    davs2_pixel_init     (cpuid, &gf_davs2);
-    davs2_mc_init        (cpuid, &gf_davs2);
-    davs2_quant_init     (cpuid, &gf_davs2);
-    davs2_dct_init       (cpuid, &gf_davs2);
-    davs2_deblock_init   (cpuid, &gf_davs2);
-    davs2_sao_init       (cpuid, &gf_davs2);
-    davs2_alf_init       (cpuid, &gf_davs2);
-
+    init_primitives(cpuid, &gf_davs2);
 }
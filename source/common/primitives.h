@@ -67,6 +67,7 @@ extern "C" {
  */
 typedef void(*block_copy_pp_t)(pel_t *dst, intptr_t i_dst, pel_t *src, intptr_t i_src, int w, int h);
 typedef void(*block_copy_sc_t)(coeff_t *dst, intptr_t i_dst, int16_t *src, intptr_t i_src, int w, int h);
+typedef void(*plane_downscale_t)(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h);
 typedef void(*block_intpl_t)(const pel_t* src, intptr_t srcStride, pel_t* dst, intptr_t dstStride, int coeffIdx);
 typedef void(*block_intpl_ext_t)(const pel_t* src, intptr_t srcStride, pel_t* dst, intptr_t dstStride, int coeffIdxX, int coeffIdxY);
 typedef void(*intpl_t)    (pel_t *dst, int i_dst, pel_t *src, int i_src, int width, int height, const int8_t *coeff);
@@ -106,6 +107,7 @@ typedef struct ao_funcs_t {
     void(*plane_copy)(pel_t *dst, intptr_t i_dst, pel_t *src, intptr_t i_src, int w, int h);
     block_copy_pp_t block_copy;
     block_copy_sc_t block_coeff_copy;
+    plane_downscale_t plane_downscale[2];   /* box filter of output planes, [0]: 1/2, [1]: 1/4 (w, h: size of dst) */
 
     copy_pp_t       copy_pp[MAX_PART_NUM];
     copy_ss_t       copy_ss[MAX_PART_NUM];
@@ -172,6 +174,8 @@ extern ao_funcs_t gf_davs2;
  */
 #define init_all_primitives FPFX(init_all_primitives)
 void init_all_primitives(uint32_t cpuid);
+#define init_primitives FPFX(init_primitives)
+void init_primitives(uint32_t cpuid, ao_funcs_t *pf);
 
 
 /* ---------------------------------------------------------------------------
@@ -269,41 +269,6 @@ static void dequant_c(coeff_t *p_coeff, const int i_coef, const int scale, const
     }
 }
 
-/* ---------------------------------------------------------------------------
- */
-static void dequant_weighted_c(coeff_t *p_coeff, int i_coeff, int bsx, int bsy, int scale, int shift, int16_t *wq_matrix, int wqm_shift, int wqm_size_id)
-{
-    const int add          = 1 << (shift - 1);
-    const int wqm_size     = 1 << (wqm_size_id + 2);
-    const int stride_shift = DAVS2_CLIP3(0, 2, wqm_size_id - 1);
-    const int stride       = wqm_size >> stride_shift;
-    int i, j;
-
-    for (j = 0; j < bsy; j++) {
-        for (i = 0; i < bsx; i++) {
-            int wqm_coef = wq_matrix[((j >> stride_shift) & (stride - 1)) * stride + ((i >> stride_shift) & (stride - 1))];
-            if (p_coeff[i]) {
-                int cur_coeff = (((((p_coeff[i] * wqm_coef) >> wqm_shift) * scale) >> 4) + add) >> shift;
-                p_coeff[i] = (coeff_t)DAVS2_CLIP3(-32768, 32767, cur_coeff);
-            }
-        }
-        p_coeff += i_coeff;
-    }
-}
-
-/* ---------------------------------------------------------------------------
- * dequant the coefficients
- */
-void dequant_coeffs(davs2_t *h, coeff_t *p_coeff, int bsx, int bsy, int scale, int shift, int WQMSizeId)
-{
-    if (h->seq_info.enable_weighted_quant) {
-        int wqm_shift = (h->wq.pic_wq_data_index == 1) ? 3 : 0;
-        dequant_weighted_c(p_coeff, bsx, bsx, bsy, scale, shift, h->wq.cur_wq_matrix[WQMSizeId], wqm_shift, WQMSizeId);
-    } else {
-        gf_davs2.dequant(p_coeff, bsx * bsy, scale, shift);
-    }
-}
-
 /* ---------------------------------------------------------------------------
  */
 void davs2_quant_init(uint32_t cpuid, ao_funcs_t *fh)
@@ -76,8 +76,6 @@ void wq_update_frame_matrix(davs2_t *h);
 
 
 /* dequant */
-#define dequant_coeffs FPFX(dequant_coeffs)
-void dequant_coeffs(davs2_t *h, coeff_t *p_coeff, int bsx, int bsy, int scale, int shift, int WQMSizeId);
 #define davs2_quant_init FPFX(quant_init)
 void davs2_quant_init(uint32_t cpuid, ao_funcs_t *fh);
 
@@ -862,6 +862,41 @@ void inv_transform(davs2_row_rec_t *row_rec, coeff_t *p_coeff, cu_t *p_cu, int i
 }
 
 
+/* ---------------------------------------------------------------------------
+ * residual value of a block in which only the DC coefficient is non-zero.
+ * all basis functions have a DC gain of 32, so both butterfly stages reduce
+ * to one multiply-shift-clip; the 5/3 wavelet of 64-point blocks halves it
+ */
+static INLINE
+int get_dc_residual(int dc, int bsx, int bsy)
+{
+    const int a_flag   = (bsx == 64 || bsy == 64);
+    const int shift2   = 20 - g_bit_depth - a_flag;
+    const int max_val1 = (1 << (LIMIT_BIT - 1)) - 1;
+    const int max_val2 = (1 << (g_bit_depth + a_flag)) - 1;
+    int v;
+
+    v = DAVS2_CLIP3(-max_val1 - 1, max_val1, (dc * 32 + 16) >> 5);
+    v = DAVS2_CLIP3(-max_val2 - 1, max_val2, (v * 32 + (1 << (shift2 - 1))) >> shift2);
+
+    return v >> a_flag;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static INLINE
+void add_dc_residual(pel_t *p_dst, int i_dst, int bsx, int bsy, int dc)
+{
+    int x, y;
+
+    for (y = 0; y < bsy; y++) {
+        for (x = 0; x < bsx; x++) {
+            p_dst[x] = (pel_t)DAVS2_CLIP1(p_dst[x] + dc);
+        }
+        p_dst += i_dst;
+    }
+}
+
 /* ---------------------------------------------------------------------------
  * copy region of h->lcu.residual[] corresponding to blockidx to p_dst
  */
@@ -902,13 +937,6 @@ void davs2_get_recons(davs2_row_rec_t *row_rec, cu_t *p_cu, int blockidx, cb_t *
 
     assert(((p_cu->i_cbp >> blockidx) & 1) != 0);
 
-    // inverse transform
-    p_tu->v >>= b_wavelet_conducted;
-    i_coeff = p_tu->w;
-    p_coeff = get_quanted_coeffs(row_rec, p_cu, blockidx);
-    inv_transform(row_rec, p_coeff, p_cu, i_coeff, bsx, bsy, h->seq_info.enable_2nd_transform, blockidx, p_cu->intra_pred_modes[blockidx]);
-    i_coeff <<= b_wavelet_conducted;
-
     if (b_luma) {
         x_start += ctu_x;
         y_start += ctu_y;
@@ -923,6 +951,21 @@ void davs2_get_recons(davs2_row_rec_t *row_rec, cu_t *p_cu, int blockidx, cb_t *
         p_dst    = row_rec->ctu.p_fdec[blockidx - 3] + y_start * i_dst + x_start;
     }
 
+    p_tu->v >>= b_wavelet_conducted;
+    i_coeff = p_tu->w;
+    p_coeff = get_quanted_coeffs(row_rec, p_cu, blockidx);
+
+    // DC only: no transform, add a constant to the prediction
+    if (p_cu->dct_pattern[blockidx] == DCT_DC &&
+        !(h->seq_info.enable_2nd_transform && IS_INTRA(p_cu) && b_luma)) {
+        add_dc_residual(p_dst, i_dst, bsx, bsy, get_dc_residual(p_coeff[0], bsx, bsy));
+        return;
+    }
+
+    // inverse transform
+    inv_transform(row_rec, p_coeff, p_cu, i_coeff, bsx, bsy, h->seq_info.enable_2nd_transform, blockidx, p_cu->intra_pred_modes[blockidx]);
+    i_coeff <<= b_wavelet_conducted;
+
     // normalize
     gf_davs2.add_ps[PART_INDEX(bsx, bsy)](p_dst, i_dst, p_dst, p_coeff, i_dst, i_coeff);
 }
@@ -1029,11 +1072,11 @@ void davs2_dct_init(uint32_t cpuid, ao_funcs_t *fh)
         fh->idct[PART_16x64][DCT_DEAULT] = idct_16x64_avx2;
         fh->idct[PART_32x32][DCT_DEAULT] = idct_32x32_avx2;    // @luofl i7-6700k ٶȱsse128һ
 
-        /* square */
-        // fh->idct[PART_8x8  ][DCT_HALF] = idct_8x8_half_avx2;
+        /* square (partial kernels not listed are slower than sse128) */
+        fh->idct[PART_8x8  ][DCT_HALF] = idct_8x8_half_avx2;
         // fh->idct[PART_8x8  ][DCT_QUAD] = idct_8x8_quad_avx2;
         // fh->idct[PART_16x16][DCT_HALF] = idct_16x16_half_avx2;
-        // fh->idct[PART_16x16][DCT_QUAD] = idct_16x16_quad_avx2;
+        fh->idct[PART_16x16][DCT_QUAD] = idct_16x16_quad_avx2;
         // fh->idct[PART_32x32][DCT_HALF] = idct_32x32_half_avx2;
         // fh->idct[PART_32x32][DCT_QUAD] = idct_32x32_quad_avx2;
         // fh->idct[PART_64x64][DCT_HALF] = idct_64x64_half_avx2;
@@ -1043,7 +1086,7 @@ void davs2_dct_init(uint32_t cpuid, ao_funcs_t *fh)
         // fh->idct[PART_4x16 ][DCT_HALF] = idct_4x16_half_avx2;
         // fh->idct[PART_4x16 ][DCT_QUAD] = idct_4x16_quad_avx2;
         // fh->idct[PART_16x4 ][DCT_HALF] = idct_16x4_half_avx2;
-        // fh->idct[PART_16x4 ][DCT_QUAD] = idct_16x4_quad_avx2;
+        fh->idct[PART_16x4 ][DCT_QUAD] = idct_16x4_quad_avx2;
         // fh->idct[PART_8x32 ][DCT_QUAD] = idct_8x32_quad_avx2;
         // fh->idct[PART_8x32 ][DCT_HALF] = idct_8x32_half_avx2;
         // fh->idct[PART_32x8 ][DCT_HALF] = idct_32x8_half_avx2;
@@ -1055,4 +1098,12 @@ void davs2_dct_init(uint32_t cpuid, ao_funcs_t *fh)
     }
 #endif  // if ARCH_X86_X64
 #endif  // if HAVE_MMX
+
+    /* DC-only blocks which can not bypass the transform (secondary transform
+     * spreads the DC into the top-left 4x4) use the kernel for the first CG */
+    for (i = 0; i < MAX_PART_NUM; i++) {
+        fh->idct[i][DCT_DC] = fh->idct[i][DCT_QUAD];
+    }
+    fh->idct[PART_4x4][DCT_DC] = fh->idct[PART_4x4][DCT_DEAULT];
+    fh->idct[PART_8x8][DCT_DC] = fh->idct[PART_8x8][DCT_HALF];
 }
@@ -143,6 +143,11 @@ void *davs2_fast_memzero_mmx     (void *dst, size_t n);
 #define plane_copy_c_sse2 FPFX(plane_copy_c_sse2)
 void plane_copy_c_sse2          (pel_t *dst, intptr_t i_dst, pel_t *src, intptr_t i_src, int w, int h);
 
+#define plane_downscale_half_sse128 FPFX(plane_downscale_half_sse128)
+void plane_downscale_half_sse128   (pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h);
+#define plane_downscale_quarter_sse128 FPFX(plane_downscale_quarter_sse128)
+void plane_downscale_quarter_sse128(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h);
+
 #define intpl_copy_block_sse128 FPFX(intpl_copy_block_sse128)
 void intpl_copy_block_sse128    (pel_t *dst, int i_dst, pel_t *src, int i_src, int width, int height);
 
@@ -484,6 +489,10 @@ void intra_pred_ang_xy_20_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode
 void intra_pred_ang_xy_22_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_xy_23_sse128 FPFX(intra_pred_ang_xy_23_sse128)
 void intra_pred_ang_xy_23_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
+#define intra_pred_ang_xy_sse128 FPFX(intra_pred_ang_xy_sse128)
+void intra_pred_ang_xy_sse128   (pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
+#define intra_pred_transpose_sse128 FPFX(intra_pred_transpose_sse128)
+void intra_pred_transpose_sse128(pel_t *src, int i_src, pel_t *dst, int i_dst, int bsx, int bsy);
 
 //intra prediction avx functions
 #define intra_pred_ver_avx FPFX(intra_pred_ver_avx)
@@ -529,13 +538,19 @@ void intra_pred_ang_xy_20_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, i
 void intra_pred_ang_xy_22_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_xy_23_avx FPFX(intra_pred_ang_xy_23_avx)
 void intra_pred_ang_xy_23_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
+#define intra_pred_ang_xy_avx FPFX(intra_pred_ang_xy_avx)
+void intra_pred_ang_xy_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 
 #define intra_pred_ang_y_25_avx FPFX(intra_pred_ang_y_25_avx)
 void intra_pred_ang_y_25_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_y_26_avx FPFX(intra_pred_ang_y_26_avx)
 void intra_pred_ang_y_26_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
+#define intra_pred_ang_y_27_avx FPFX(intra_pred_ang_y_27_avx)
+void intra_pred_ang_y_27_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_y_28_avx FPFX(intra_pred_ang_y_28_avx)
 void intra_pred_ang_y_28_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
+#define intra_pred_ang_y_29_avx FPFX(intra_pred_ang_y_29_avx)
+void intra_pred_ang_y_29_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_y_30_avx FPFX(intra_pred_ang_y_30_avx)
 void intra_pred_ang_y_30_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy);
 #define intra_pred_ang_y_31_avx FPFX(intra_pred_ang_y_31_avx)
@@ -2165,3 +2165,138 @@ void idct_16x64_avx2(const coeff_t *src, coeff_t *dst, int i_dst)
     idct_8x32_sse128(src, dst, 8 | 0x01);//TODO: change the code to avx2
     inv_wavelet_16x64_avx2(dst);
 }
+
+
+/* ---------------------------------------------------------------------------
+ * partial inverse transforms
+ * ---------------------------------------------------------------------------
+ * Blocks whose non-zero coefficients lie in the top-left (num_x, num_y)
+ * corner are transformed as matrix products restricted to the non-zero
+ * rows and columns (up to 16x16). tab_idct_pairs_N[k/2][] holds the
+ * N-point basis functions k and k+1 interleaved, so that one
+ * _mm256_madd_epi16 adds both for 8 samples. Only faster than the SSE
+ * butterflies when few coefficient rows and columns are non-zero.
+ */
+ALIGN32(static const int16_t tab_idct_pairs_4[2][8]) = {
+    {  32,  42,  32,  17,  32, -17,  32, -42 },
+    {  32,  17, -32, -42, -32,  42,  32, -17 },
+};
+
+ALIGN32(static const int16_t tab_idct_pairs_8[4][16]) = {
+    {  32,  44,  32,  38,  32,  25,  32,   9,  32,  -9,  32, -25,  32, -38,  32, -44 },
+    {  42,  38,  17,  -9, -17, -44, -42, -25, -42,  25, -17,  44,  17,   9,  42, -38 },
+    {  32,  25, -32, -44, -32,   9,  32,  38,  32, -38, -32,  -9, -32,  44,  32, -25 },
+    {  17,   9, -42, -25,  42,  38, -17, -44, -17,  44,  42, -38, -42,  25,  17,  -9 },
+};
+
+ALIGN32(static const int16_t tab_idct_pairs_16[8][32]) = {
+    {  32,  45,  32,  43,  32,  40,  32,  35,  32,  29,  32,  21,  32,  13,  32,   4,  32,  -4,  32, -13,  32, -21,  32, -29,  32, -35,  32, -40,  32, -43,  32, -45 },
+    {  44,  43,  38,  29,  25,   4,   9, -21,  -9, -40, -25, -45, -38, -35, -44, -13, -44,  13, -38,  35, -25,  45,  -9,  40,   9,  21,  25,  -4,  38, -29,  44, -43 },
+    {  42,  40,  17,   4, -17, -35, -42, -43, -42, -13, -17,  29,  17,  45,  42,  21,  42, -21,  17, -45, -17, -29, -42,  13, -42,  43, -17,  35,  17,  -4,  42, -40 },
+    {  38,  35,  -9, -21, -44, -43, -25,   4,  25,  45,  44,  13,   9, -40, -38, -29, -38,  29,   9,  40,  44, -13,  25, -45, -25,  -4, -44,  43,  -9,  21,  38, -35 },
+    {  32,  29, -32, -40, -32, -13,  32,  45,  32,  -4, -32, -43, -32,  21,  32,  35,  32, -35, -32, -21, -32,  43,  32,   4,  32, -45, -32,  13, -32,  40,  32, -29 },
+    {  25,  21, -44, -45,   9,  29,  38,  13, -38, -43,  -9,  35,  44,   4, -25, -40, -25,  40,  44,  -4,  -9, -35, -38,  43,  38, -13,   9, -29, -44,  45,  25, -21 },
+    {  17,  13, -42, -35,  42,  45, -17, -40, -17,  21,  42,   4, -42, -29,  17,  43,  17, -43, -42,  29,  42,  -4, -17, -21, -17,  40,  42, -45, -42,  35,  17, -13 },
+    {   9,   4, -25, -13,  38,  21, -44, -29,  44,  35, -38, -40,  25,  43,  -9, -45,  -9,  45,  25, -43, -38,  40,  44, -35, -44,  29,  38, -21, -25,  13,   9,  -4 },
+};
+
+
+/* ---------------------------------------------------------------------------
+ * broadcast the 32-bit pair p[0], p[1]
+ */
+static ALWAYS_INLINE
+__m256i idct_bcast_pair(const int16_t *p)
+{
+    int32_t v;
+    memcpy(&v, p, sizeof(v));
+    return _mm256_set1_epi32(v);
+}
+
+/* ---------------------------------------------------------------------------
+ * w x h inverse transform with non-zero coefficients only in the top-left
+ * num_x x num_y corner (the lowest bit of i_dst is the wavelet flag)
+ */
+static ALWAYS_INLINE
+void idct_partial_avx2(const coeff_t *src, coeff_t *dst, int i_dst, int w, int h, int num_x, int num_y)
+{
+    ALIGN32(coeff_t tmp[16 * 16]);
+    const int16_t *pairs_w = w == 4 ? tab_idct_pairs_4[0] : w == 8 ? tab_idct_pairs_8[0] : tab_idct_pairs_16[0];
+    const int16_t *pairs_h = h == 4 ? tab_idct_pairs_4[0] : h == 8 ? tab_idct_pairs_8[0] : tab_idct_pairs_16[0];
+    const int a_flag = i_dst & 0x01;
+    const int shift2 = 20 - g_bit_depth - a_flag;
+    const __m256i rnd1 = _mm256_set1_epi32(16);
+    const __m256i rnd2 = _mm256_set1_epi32(1 << (shift2 - 1));
+    const __m128i max_val = _mm_set1_epi16((int16_t)((1 << (g_bit_depth + a_flag)) - 1));
+    const __m128i min_val = _mm_set1_epi16((int16_t)(-(1 << (g_bit_depth + a_flag))));
+    __m256i in[8];
+    int x, y, k;
+
+    i_dst &= 0xFE;
+    assert((num_x & 1) == 0 && (num_y & 1) == 0);
+
+    /* vertical: tmp[y][x] = sum_k T_h[k][y] * src[k][x], y < h, x < num_x */
+    for (x = 0; x < num_x; x += 8) {
+        for (k = 0; k < num_y; k += 2) {
+            __m128i r0, r1;
+            if (num_x - x < 8) {
+                r0 = _mm_loadl_epi64((const __m128i *)(src + (k    ) * w + x));
+                r1 = _mm_loadl_epi64((const __m128i *)(src + (k + 1) * w + x));
+            } else {
+                r0 = _mm_loadu_si128((const __m128i *)(src + (k    ) * w + x));
+                r1 = _mm_loadu_si128((const __m128i *)(src + (k + 1) * w + x));
+            }
+            in[k >> 1] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(r0, r1)), _mm_unpackhi_epi16(r0, r1), 1);
+        }
+        for (y = 0; y < h; y++) {
+            __m256i sum = _mm256_madd_epi16(in[0], idct_bcast_pair(pairs_h + 2 * y));
+            for (k = 2; k < num_y; k += 2) {
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(in[k >> 1], idct_bcast_pair(pairs_h + (k >> 1) * 2 * h + 2 * y)));
+            }
+            sum = _mm256_srai_epi32(_mm256_add_epi32(sum, rnd1), 5);
+            /* LIMIT_BIT is 16, saturation is the clipping */
+            _mm_storeu_si128((__m128i *)(tmp + y * 16 + x), _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+        }
+    }
+
+    /* horizontal: dst[y][x] = sum_k T_w[k][x] * tmp[y][k], x < w */
+    for (y = 0; y < h; y++) {
+        for (k = 0; k < num_x; k += 2) {
+            in[k >> 1] = idct_bcast_pair(tmp + y * 16 + k);
+        }
+        for (x = 0; x < w; x += 8) {
+            __m256i sum;
+            __m128i res;
+            if (w == 4) {
+                sum = _mm256_madd_epi16(in[0], _mm256_castsi128_si256(_mm_load_si128((const __m128i *)pairs_w)));
+                for (k = 2; k < num_x; k += 2) {
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(in[k >> 1], _mm256_castsi128_si256(_mm_load_si128((const __m128i *)(pairs_w + (k >> 1) * 2 * w)))));
+                }
+            } else {
+                sum = _mm256_madd_epi16(in[0], _mm256_load_si256((const __m256i *)(pairs_w + 2 * x)));
+                for (k = 2; k < num_x; k += 2) {
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(in[k >> 1], _mm256_load_si256((const __m256i *)(pairs_w + (k >> 1) * 2 * w + 2 * x))));
+                }
+            }
+            sum = _mm256_srai_epi32(_mm256_add_epi32(sum, rnd2), shift2);
+            res = _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            res = _mm_min_epi16(_mm_max_epi16(res, min_val), max_val);
+            if (w == 4) {
+                _mm_storel_epi64((__m128i *)(dst + y * i_dst), res);
+            } else {
+                _mm_storeu_si128((__m128i *)(dst + y * i_dst + x), res);
+            }
+        }
+    }
+}
+
+#define IDCT_PARTIAL_AVX2(name, w, h, num_x, num_y) \
+void name(const coeff_t *src, coeff_t *dst, int i_dst)\
+{\
+    idct_partial_avx2(src, dst, i_dst, w, h, num_x, num_y);\
+}
+
+IDCT_PARTIAL_AVX2(idct_8x8_half_avx2,    8,  8,  4,  4)
+IDCT_PARTIAL_AVX2(idct_16x16_quad_avx2, 16, 16,  4,  4)
+IDCT_PARTIAL_AVX2(idct_16x4_quad_avx2,  16,  4,  4,  4)
+
+#undef IDCT_PARTIAL_AVX2
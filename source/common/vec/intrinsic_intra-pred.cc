@@ -2496,7 +2496,9 @@ void intra_pred_ang_x_7_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 
     UNUSED_PARAMETER(dir_mode);
 
-    if (bsx >= bsy) {
+    /* the reference samples are not clipped at (2 * bsx) with BUGFIX_PREDICTION_INTRA,
+     * blocks with (bsx < bsy) are predicted the same way as the others */
+    if (BUGFIX_PREDICTION_INTRA || bsx >= bsy) {
         if (bsx & 0x07) {
             __m128i D0;
             int i_dst2 = i_dst << 1;
@@ -3032,7 +3034,9 @@ void intra_pred_ang_x_9_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 
     UNUSED_PARAMETER(dir_mode);
 
-    if (bsx >= bsy) {
+    /* the reference samples are not clipped at (2 * bsx) with BUGFIX_PREDICTION_INTRA,
+     * blocks with (bsx < bsy) are predicted the same way as the others */
+    if (BUGFIX_PREDICTION_INTRA || bsx >= bsy) {
         if (bsx & 0x07) {
             __m128i D0;
             int i_dst2 = i_dst << 1;
@@ -3963,6 +3967,251 @@ void intra_pred_ang_x_11_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 }
 
 
+/* ---------------------------------------------------------------------------
+ * transpose a predicted block: src holds bsx rows of bsy pixels, dst gets bsy
+ * rows of bsx pixels. Used by the y modes which are predicted as x modes
+ */
+void intra_pred_transpose_sse128(pel_t *src, int i_src, pel_t *dst, int i_dst, int bsx, int bsy)
+{
+    int i;
+
+    if ((bsy > 4) && (bsx > 4)) {
+        pel_t *pDst_128[64];
+        pel_t *pTra_128[64];
+
+        int iSize_x = bsx >> 3;
+        int iSize_y = bsy >> 3;
+        int iSize = iSize_x * iSize_y;
+
+        for (int y = 0; y < iSize_y; y++) {
+            for (int x = 0; x < iSize_x; x++) {
+                pDst_128[x + y * iSize_x] = dst      + x * 8 + y * 8 * i_dst;
+                pTra_128[x + y * iSize_x] = src + y * 8 + x * 8 * i_src;
+            }
+        }
+
+        for (i = 0; i < iSize; i++) {
+            pel_t *src_org = pTra_128[i];
+
+            pel_t *dst1 = pDst_128[i];
+            pel_t *dst2 = dst1 + i_dst;
+            pel_t *dst3 = dst2 + i_dst;
+            pel_t *dst4 = dst3 + i_dst;
+            pel_t *dst5 = dst4 + i_dst;
+            pel_t *dst6 = dst5 + i_dst;
+            pel_t *dst7 = dst6 + i_dst;
+            pel_t *dst8 = dst7 + i_dst;
+            __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3, Org_8_4, Org_8_5, Org_8_6, Org_8_7;
+            __m128i p00, p10, p20, p30;
+            __m128i t00, t10, t20, t30;
+            Org_8_0 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_1 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_2 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_3 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_4 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_5 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_6 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_7 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+
+            p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
+            p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
+            p20 = _mm_unpacklo_epi8(Org_8_4, Org_8_5);
+            p30 = _mm_unpacklo_epi8(Org_8_6, Org_8_7);
+
+            t00 = _mm_unpacklo_epi16(p00, p10);
+            t20 = _mm_unpacklo_epi16(p20, p30);
+            t10 = _mm_unpackhi_epi16(p00, p10);
+            t30 = _mm_unpackhi_epi16(p20, p30);
+
+            p00 = _mm_unpacklo_epi32(t00, t20);
+            p10 = _mm_unpackhi_epi32(t00, t20);
+            p20 = _mm_unpacklo_epi32(t10, t30);
+            p30 = _mm_unpackhi_epi32(t10, t30);
+
+            _mm_storel_epi64((__m128i*)dst1, p00);
+            p00 = _mm_srli_si128(p00, 8);
+            _mm_storel_epi64((__m128i*)dst2, p00);
+
+            _mm_storel_epi64((__m128i*)dst3, p10);
+            p10 = _mm_srli_si128(p10, 8);
+            _mm_storel_epi64((__m128i*)dst4, p10);
+
+            _mm_storel_epi64((__m128i*)dst5, p20);
+            p20 = _mm_srli_si128(p20, 8);
+            _mm_storel_epi64((__m128i*)dst6, p20);
+
+            _mm_storel_epi64((__m128i*)dst7, p30);
+            p30 = _mm_srli_si128(p30, 8);
+            _mm_storel_epi64((__m128i*)dst8, p30);
+        }
+    } else if (bsx == 16) {
+        for (i = 0; i < 2; i++) {
+            pel_t *src_org = src + i * 8 * i_src;
+
+            pel_t *dst1 = dst + i * 8;
+            pel_t *dst2 = dst1 + i_dst;
+            pel_t *dst3 = dst2 + i_dst;
+            pel_t *dst4 = dst3 + i_dst;
+
+            __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3, Org_8_4, Org_8_5, Org_8_6, Org_8_7;
+            __m128i p00, p10, p20, p30;
+            __m128i t00, t20;
+            Org_8_0 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_1 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_2 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_3 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_4 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_5 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_6 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+            Org_8_7 = _mm_loadu_si128((__m128i*)src_org);
+            src_org += i_src;
+
+            p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
+            p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
+            p20 = _mm_unpacklo_epi8(Org_8_4, Org_8_5);
+            p30 = _mm_unpacklo_epi8(Org_8_6, Org_8_7);
+
+            t00 = _mm_unpacklo_epi16(p00, p10);
+            t20 = _mm_unpacklo_epi16(p20, p30);
+
+            p00 = _mm_unpacklo_epi32(t00, t20);
+            p10 = _mm_unpackhi_epi32(t00, t20);
+
+            _mm_storel_epi64((__m128i*)dst1, p00);
+            p00 = _mm_srli_si128(p00, 8);
+            _mm_storel_epi64((__m128i*)dst2, p00);
+
+            _mm_storel_epi64((__m128i*)dst3, p10);
+            p10 = _mm_srli_si128(p10, 8);
+            _mm_storel_epi64((__m128i*)dst4, p10);
+        }
+    } else if (bsy == 16) {//bsx == 4
+        pel_t *src_org = src;
+
+        pel_t *dst1 = dst;
+        pel_t *dst2 = dst1 + i_dst;
+        pel_t *dst3 = dst2 + i_dst;
+        pel_t *dst4 = dst3 + i_dst;
+        pel_t *dst5 = dst4 + i_dst;
+        pel_t *dst6 = dst5 + i_dst;
+        pel_t *dst7 = dst6 + i_dst;
+        pel_t *dst8 = dst7 + i_dst;
+
+        __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3;
+        __m128i p00, p10;
+        __m128i t00, t10;
+        Org_8_0 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_1 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_2 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_3 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+
+        p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
+        p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
+
+        t00 = _mm_unpacklo_epi16(p00, p10);
+        t10 = _mm_unpackhi_epi16(p00, p10);
+
+        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
+
+        *((int*)(dst5)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst6)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst7)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst8)) = _mm_cvtsi128_si32(t10);
+
+        dst1 = dst8 + i_dst;
+        dst2 = dst1 + i_dst;
+        dst3 = dst2 + i_dst;
+        dst4 = dst3 + i_dst;
+        dst5 = dst4 + i_dst;
+        dst6 = dst5 + i_dst;
+        dst7 = dst6 + i_dst;
+        dst8 = dst7 + i_dst;
+
+        p00 = _mm_unpackhi_epi8(Org_8_0, Org_8_1);
+        p10 = _mm_unpackhi_epi8(Org_8_2, Org_8_3);
+
+        t00 = _mm_unpacklo_epi16(p00, p10);
+        t10 = _mm_unpackhi_epi16(p00, p10);
+
+        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
+
+        *((int*)(dst5)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst6)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst7)) = _mm_cvtsi128_si32(t10);
+        t10 = _mm_srli_si128(t10, 4);
+        *((int*)(dst8)) = _mm_cvtsi128_si32(t10);
+    } else {// bsx == 4 bsy ==4
+        pel_t *src_org = src;
+
+        pel_t *dst1 = dst;
+        pel_t *dst2 = dst1 + i_dst;
+        pel_t *dst3 = dst2 + i_dst;
+        pel_t *dst4 = dst3 + i_dst;
+
+        __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3;
+        __m128i p00, p10;
+        __m128i t00;
+        Org_8_0 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_1 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_2 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+        Org_8_3 = _mm_loadu_si128((__m128i*)src_org);
+        src_org += i_src;
+
+        p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
+        p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
+
+        t00 = _mm_unpacklo_epi16(p00, p10);
+
+        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
+        t00 = _mm_srli_si128(t00, 4);
+        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
+    }
+}
+
+
 /* ---------------------------------------------------------------------------
 */
 void intra_pred_ang_y_25_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
@@ -4876,6 +5125,28 @@ void intra_pred_ang_y_26_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 }
 
 
+/* ---------------------------------------------------------------------------
+ * the transposed block is predicted with mode 9, which has the same angle
+ */
+void intra_pred_ang_y_27_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    ALIGN16(pel_t dst_tran[64 * 80]);
+    ALIGN16(pel_t src_tran[64 * 8]);
+    int i_dst2 = (((bsy + 15) >> 4) << 4) + 16;
+    int i;
+
+    UNUSED_PARAMETER(dir_mode);
+
+    for (i = 0; i < (bsy + ((bsx * 93) >> 8) + 3); i++) {
+        src_tran[i] = src[-i];
+    }
+
+    intra_pred_ang_x_9_sse128(src_tran, dst_tran, i_dst2, 9, bsy, bsx);
+
+    intra_pred_transpose_sse128(dst_tran, i_dst2, dst, i_dst, bsx, bsy);
+}
+
+
 /* ---------------------------------------------------------------------------
 */
 void intra_pred_ang_y_28_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
@@ -5045,6 +5316,28 @@ void intra_pred_ang_y_28_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 }
 
 
+/* ---------------------------------------------------------------------------
+ * the transposed block is predicted with mode 7, which has the same angle
+ */
+void intra_pred_ang_y_29_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    ALIGN16(pel_t dst_tran[64 * 80]);
+    ALIGN16(pel_t src_tran[64 * 8]);
+    int i_dst2 = (((bsy + 15) >> 4) << 4) + 16;
+    int i;
+
+    UNUSED_PARAMETER(dir_mode);
+
+    for (i = 0; i < (bsy + ((bsx * 93) >> 7) + 3); i++) {
+        src_tran[i] = src[-i];
+    }
+
+    intra_pred_ang_x_7_sse128(src_tran, dst_tran, i_dst2, 7, bsy, bsx);
+
+    intra_pred_transpose_sse128(dst_tran, i_dst2, dst, i_dst, bsx, bsy);
+}
+
+
 /* ---------------------------------------------------------------------------
 */
 void intra_pred_ang_y_30_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
@@ -5324,241 +5617,7 @@ void intra_pred_ang_y_31_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode,
 
     intra_pred_ang_x_5_sse128(src_tran, dst_tran, i_dst2, 5, bsy, bsx);
 
-    if ((bsy > 4) && (bsx > 4)) {
-        pel_t *pDst_128[64];
-        pel_t *pTra_128[64];
-
-        int iSize_x = bsx >> 3;
-        int iSize_y = bsy >> 3;
-        int iSize = iSize_x * iSize_y;
-
-        for (int y = 0; y < iSize_y; y++) {
-            for (int x = 0; x < iSize_x; x++) {
-                pDst_128[x + y * iSize_x] = dst      + x * 8 + y * 8 * i_dst;
-                pTra_128[x + y * iSize_x] = dst_tran + y * 8 + x * 8 * i_dst2;
-            }
-        }
-
-        for (i = 0; i < iSize; i++) {
-            pel_t *dst_tran_org = pTra_128[i];
-
-            pel_t *dst1 = pDst_128[i];
-            pel_t *dst2 = dst1 + i_dst;
-            pel_t *dst3 = dst2 + i_dst;
-            pel_t *dst4 = dst3 + i_dst;
-            pel_t *dst5 = dst4 + i_dst;
-            pel_t *dst6 = dst5 + i_dst;
-            pel_t *dst7 = dst6 + i_dst;
-            pel_t *dst8 = dst7 + i_dst;
-            __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3, Org_8_4, Org_8_5, Org_8_6, Org_8_7;
-            __m128i p00, p10, p20, p30;
-            __m128i t00, t10, t20, t30;
-            Org_8_0 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_1 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_2 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_3 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_4 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_5 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_6 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_7 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-
-            p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
-            p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
-            p20 = _mm_unpacklo_epi8(Org_8_4, Org_8_5);
-            p30 = _mm_unpacklo_epi8(Org_8_6, Org_8_7);
-
-            t00 = _mm_unpacklo_epi16(p00, p10);
-            t20 = _mm_unpacklo_epi16(p20, p30);
-            t10 = _mm_unpackhi_epi16(p00, p10);
-            t30 = _mm_unpackhi_epi16(p20, p30);
-
-            p00 = _mm_unpacklo_epi32(t00, t20);
-            p10 = _mm_unpackhi_epi32(t00, t20);
-            p20 = _mm_unpacklo_epi32(t10, t30);
-            p30 = _mm_unpackhi_epi32(t10, t30);
-
-            _mm_storel_epi64((__m128i*)dst1, p00);
-            p00 = _mm_srli_si128(p00, 8);
-            _mm_storel_epi64((__m128i*)dst2, p00);
-
-            _mm_storel_epi64((__m128i*)dst3, p10);
-            p10 = _mm_srli_si128(p10, 8);
-            _mm_storel_epi64((__m128i*)dst4, p10);
-
-            _mm_storel_epi64((__m128i*)dst5, p20);
-            p20 = _mm_srli_si128(p20, 8);
-            _mm_storel_epi64((__m128i*)dst6, p20);
-
-            _mm_storel_epi64((__m128i*)dst7, p30);
-            p30 = _mm_srli_si128(p30, 8);
-            _mm_storel_epi64((__m128i*)dst8, p30);
-        }
-    } else if (bsx == 16) {
-        for (i = 0; i < 2; i++) {
-            pel_t *dst_tran_org = dst_tran + i * 8 * i_dst2;
-
-            pel_t *dst1 = dst + i * 8;
-            pel_t *dst2 = dst1 + i_dst;
-            pel_t *dst3 = dst2 + i_dst;
-            pel_t *dst4 = dst3 + i_dst;
-
-            __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3, Org_8_4, Org_8_5, Org_8_6, Org_8_7;
-            __m128i p00, p10, p20, p30;
-            __m128i t00, t20;
-            Org_8_0 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_1 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_2 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_3 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_4 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_5 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_6 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-            Org_8_7 = _mm_loadu_si128((__m128i*)dst_tran_org);
-            dst_tran_org += i_dst2;
-
-            p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
-            p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
-            p20 = _mm_unpacklo_epi8(Org_8_4, Org_8_5);
-            p30 = _mm_unpacklo_epi8(Org_8_6, Org_8_7);
-
-            t00 = _mm_unpacklo_epi16(p00, p10);
-            t20 = _mm_unpacklo_epi16(p20, p30);
-
-            p00 = _mm_unpacklo_epi32(t00, t20);
-            p10 = _mm_unpackhi_epi32(t00, t20);
-
-            _mm_storel_epi64((__m128i*)dst1, p00);
-            p00 = _mm_srli_si128(p00, 8);
-            _mm_storel_epi64((__m128i*)dst2, p00);
-
-            _mm_storel_epi64((__m128i*)dst3, p10);
-            p10 = _mm_srli_si128(p10, 8);
-            _mm_storel_epi64((__m128i*)dst4, p10);
-        }
-    } else if (bsy == 16) {//bsx == 4
-        pel_t *dst_tran_org = dst_tran;
-
-        pel_t *dst1 = dst;
-        pel_t *dst2 = dst1 + i_dst;
-        pel_t *dst3 = dst2 + i_dst;
-        pel_t *dst4 = dst3 + i_dst;
-        pel_t *dst5 = dst4 + i_dst;
-        pel_t *dst6 = dst5 + i_dst;
-        pel_t *dst7 = dst6 + i_dst;
-        pel_t *dst8 = dst7 + i_dst;
-
-        __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3;
-        __m128i p00, p10;
-        __m128i t00, t10;
-        Org_8_0 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_1 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_2 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_3 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-
-        p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
-        p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
-
-        t00 = _mm_unpacklo_epi16(p00, p10);
-        t10 = _mm_unpackhi_epi16(p00, p10);
-
-        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
-
-        *((int*)(dst5)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst6)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst7)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst8)) = _mm_cvtsi128_si32(t10);
-
-        dst1 = dst8 + i_dst;
-        dst2 = dst1 + i_dst;
-        dst3 = dst2 + i_dst;
-        dst4 = dst3 + i_dst;
-        dst5 = dst4 + i_dst;
-        dst6 = dst5 + i_dst;
-        dst7 = dst6 + i_dst;
-        dst8 = dst7 + i_dst;
-
-        p00 = _mm_unpackhi_epi8(Org_8_0, Org_8_1);
-        p10 = _mm_unpackhi_epi8(Org_8_2, Org_8_3);
-
-        t00 = _mm_unpacklo_epi16(p00, p10);
-        t10 = _mm_unpackhi_epi16(p00, p10);
-
-        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
-
-        *((int*)(dst5)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst6)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst7)) = _mm_cvtsi128_si32(t10);
-        t10 = _mm_srli_si128(t10, 4);
-        *((int*)(dst8)) = _mm_cvtsi128_si32(t10);
-    } else {// bsx == 4 bsy ==4
-        pel_t *dst_tran_org = dst_tran;
-
-        pel_t *dst1 = dst;
-        pel_t *dst2 = dst1 + i_dst;
-        pel_t *dst3 = dst2 + i_dst;
-        pel_t *dst4 = dst3 + i_dst;
-
-        __m128i Org_8_0, Org_8_1, Org_8_2, Org_8_3;
-        __m128i p00, p10;
-        __m128i t00;
-        Org_8_0 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_1 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_2 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-        Org_8_3 = _mm_loadu_si128((__m128i*)dst_tran_org);
-        dst_tran_org += i_dst2;
-
-        p00 = _mm_unpacklo_epi8(Org_8_0, Org_8_1);
-        p10 = _mm_unpacklo_epi8(Org_8_2, Org_8_3);
-
-        t00 = _mm_unpacklo_epi16(p00, p10);
-
-        *((int*)(dst1)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst2)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst3)) = _mm_cvtsi128_si32(t00);
-        t00 = _mm_srli_si128(t00, 4);
-        *((int*)(dst4)) = _mm_cvtsi128_si32(t00);
-    }
-
+    intra_pred_transpose_sse128(dst_tran, i_dst2, dst, i_dst, bsx, bsy);
 }
 
 
@@ -8302,4 +8361,110 @@ void intra_pred_ang_xy_23_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode
 
 }
 
+/* ---------------------------------------------------------------------------
+ * dx/dy and dy/dx of the xy modes 15, 17, 19 and 21 (index: (dir_mode - 15) >> 1)
+ */
+static const int8_t tab_xy_odd_dxdy[4][2][2] = {
+    { { 93, 8 }, { 11, 2 } },
+    { { 93, 7 }, { 11, 3 } },
+    { { 11, 3 }, { 93, 7 } },
+    { { 11, 2 }, { 93, 8 } },
+};
+
+/* ---------------------------------------------------------------------------
+ * 16 pixels of (p[0] * c0 + p[1] * c1 + p[2] * c2 + p[3] * c3 + 64) >> 7,
+ * c01 and c23 hold the coefficient pairs as bytes
+ */
+static INLINE __m128i intra_pred_4tap_sse128(const pel_t *p, __m128i c01, __m128i c23)
+{
+    __m128i off = _mm_set1_epi16(64);
+    __m128i A = _mm_loadu_si128((const __m128i*)(p    ));
+    __m128i B = _mm_loadu_si128((const __m128i*)(p + 1));
+    __m128i C = _mm_loadu_si128((const __m128i*)(p + 2));
+    __m128i D = _mm_loadu_si128((const __m128i*)(p + 3));
+    __m128i L, H;
+
+    L = _mm_add_epi16(_mm_maddubs_epi16(_mm_unpacklo_epi8(A, B), c01), _mm_maddubs_epi16(_mm_unpacklo_epi8(C, D), c23));
+    H = _mm_add_epi16(_mm_maddubs_epi16(_mm_unpackhi_epi8(A, B), c01), _mm_maddubs_epi16(_mm_unpackhi_epi8(C, D), c23));
+    L = _mm_srli_epi16(_mm_add_epi16(L, off), 7);
+    H = _mm_srli_epi16(_mm_add_epi16(H, off), 7);
+
+    return _mm_packus_epi16(L, H);
+}
+
+/* ---------------------------------------------------------------------------
+ * coefficient pairs of the 4-tap filter with the given offset
+ */
+static INLINE void intra_pred_4tap_coef(int offset, __m128i *c01, __m128i *c23)
+{
+    *c01 = _mm_set1_epi16((short)(((32 + offset) << 8) | offset));
+    *c23 = _mm_set1_epi16((short)(((32 - offset) << 8) | (64 - offset)));
+}
+
+/* ---------------------------------------------------------------------------
+ * generic prediction of the xy modes 15, 17, 19 and 21, the pixels predicted
+ * from the left column are computed on the transposed block
+ */
+void intra_pred_ang_xy_sse128(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    ALIGN16(pel_t left_tran[64 * 80]);  /* bsx rows of bsy pixels */
+    ALIGN16(pel_t left[64 * 80]);       /* bsy rows of bsx pixels */
+    ALIGN16(pel_t rsrc[64 + 64 + 48]);
+    ALIGN16(int8_t xsteps[64]);
+    const int8_t (*dxdy)[2] = tab_xy_odd_dxdy[(dir_mode - 15) >> 1];
+    const int i_tran = 80;
+    pel_t *r = rsrc + 64;               /* r[k] = src[-k] */
+    __m128i c01, c23, T, L, mask;
+    int i, j, d, xs, x0, offset;
+
+    memset(rsrc, 0, sizeof(rsrc));
+    for (i = -1; i <= bsy + 1; i++) {
+        r[i] = src[-i];
+    }
+
+    /* left column, predicted along the columns of the block */
+    for (i = 0; i < bsx; i++) {
+        d      = (i + 1) * dxdy[1][0];
+        xs     = d >> dxdy[1][1];
+        offset = ((d << 5) >> dxdy[1][1]) - (xs << 5);
+        xsteps[i] = (int8_t)DAVS2_MIN(xs, 127);
+
+        if (xs < bsy) {
+            pel_t *p = r - xs - 1;
+            intra_pred_4tap_coef(offset, &c01, &c23);
+            for (j = 0; j < bsy; j += 16) {
+                _mm_storeu_si128((__m128i*)(left_tran + i * i_tran + j), intra_pred_4tap_sse128(p + j, c01, c23));
+            }
+        }
+    }
+    intra_pred_transpose_sse128(left_tran, i_tran, left, i_tran, bsx, bsy);
+
+    /* top row, and select the top or the left prediction for each pixel */
+    for (j = 0; j < bsy; j++) {
+        pel_t *p;
+        __m128i row = _mm_set1_epi8((char)j);
+
+        d      = (j + 1) * dxdy[0][0];
+        x0     = d >> dxdy[0][1];
+        offset = ((d << 5) >> dxdy[0][1]) - (x0 << 5);
+        p      = src - x0 - 1;
+        intra_pred_4tap_coef(offset, &c01, &c23);
+
+        for (i = 0; i < bsx; i += 16) {
+            T    = intra_pred_4tap_sse128(p + i, c01, c23);
+            L    = _mm_loadu_si128((const __m128i*)(left + j * i_tran + i));
+            mask = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)(xsteps + i)), row);
+            T    = _mm_blendv_epi8(L, T, mask);
+            if (bsx >= 16) {
+                _mm_storeu_si128((__m128i*)(dst + i), T);
+            } else if (bsx == 8) {
+                _mm_storel_epi64((__m128i*)dst, T);
+            } else {
+                *(int *)dst = _mm_cvtsi128_si32(T);
+            }
+        }
+        dst += i_dst;
+    }
+}
+
 #endif // #if !HIGH_BIT_DEPTH
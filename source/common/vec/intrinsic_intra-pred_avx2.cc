@@ -2128,6 +2128,11 @@ void intra_pred_ang_x_7_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int
 
 void intra_pred_ang_x_8_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
 {
+    if (bsy == 4) {
+        /* the rows are written 8 at a time below */
+        intra_pred_ang_x_8_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
 
     ALIGN32(pel_t first_line[2 * (64 + 48)]);
     int line_size = bsx + (bsy >> 1) - 1;
@@ -4484,6 +4489,11 @@ void intra_pred_ang_y_31_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, in
 
 void intra_pred_ang_y_32_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
 {
+    if (bsy == 4) {
+        /* the rows are written 8 at a time below */
+        intra_pred_ang_y_32_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
     ALIGN32(pel_t first_line[2 * (64 + 64)]);
     int line_size = (bsy >> 1) + bsx - 1;
 
@@ -5952,7 +5962,12 @@ void intra_pred_ang_xy_14_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, i
 }
 
 void intra_pred_ang_xy_16_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
-{  
+{
+    if (bsy == 4) {
+        /* the rows are written 8 at a time below */
+        intra_pred_ang_xy_16_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
     ALIGN32(pel_t first_line[2 * (64 + 48)]);
     int line_size = bsx + bsy / 2 - 1;
     int left_size = line_size - bsx;
@@ -7615,4 +7630,151 @@ void intra_pred_ang_xy_23_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, i
     }
 }
 
+/* ---------------------------------------------------------------------------
+ * the transposed block is predicted with mode 9, which has the same angle
+ */
+void intra_pred_ang_y_27_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    ALIGN32(pel_t dst_tran[64 * 80]);
+    ALIGN32(pel_t src_tran[64 * 8]);
+    int i_dst2 = (((bsy + 15) >> 4) << 4) + 16;
+    int i;
+
+    if (bsx < 16 || bsy < 16) {
+        intra_pred_ang_y_27_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
+
+    for (i = 0; i < (bsy + ((bsx * 93) >> 8) + 3); i++) {
+        src_tran[i] = src[-i];
+    }
+
+    intra_pred_ang_x_9_avx(src_tran, dst_tran, i_dst2, 9, bsy, bsx);
+
+    intra_pred_transpose_sse128(dst_tran, i_dst2, dst, i_dst, bsx, bsy);
+}
+
+/* ---------------------------------------------------------------------------
+ * the transposed block is predicted with mode 7, which has the same angle
+ */
+void intra_pred_ang_y_29_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    ALIGN32(pel_t dst_tran[64 * 80]);
+    ALIGN32(pel_t src_tran[64 * 8]);
+    int i_dst2 = (((bsy + 15) >> 4) << 4) + 16;
+    int i;
+
+    if (bsx < 16 || bsy < 16) {
+        intra_pred_ang_y_29_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
+
+    for (i = 0; i < (bsy + ((bsx * 93) >> 7) + 3); i++) {
+        src_tran[i] = src[-i];
+    }
+
+    intra_pred_ang_x_7_avx(src_tran, dst_tran, i_dst2, 7, bsy, bsx);
+
+    intra_pred_transpose_sse128(dst_tran, i_dst2, dst, i_dst, bsx, bsy);
+}
+
+/* ---------------------------------------------------------------------------
+ * 32 pixels of (p[0] * c0 + p[1] * c1 + p[2] * c2 + p[3] * c3 + 64) >> 7,
+ * the unpacks and the pack work in lanes and keep the pixel order
+ */
+static INLINE __m256i intra_pred_4tap_avx(const pel_t *p, __m256i c01, __m256i c23)
+{
+    __m256i off = _mm256_set1_epi16(64);
+    __m256i A = _mm256_loadu_si256((const __m256i*)(p    ));
+    __m256i B = _mm256_loadu_si256((const __m256i*)(p + 1));
+    __m256i C = _mm256_loadu_si256((const __m256i*)(p + 2));
+    __m256i D = _mm256_loadu_si256((const __m256i*)(p + 3));
+    __m256i L, H;
+
+    L = _mm256_add_epi16(_mm256_maddubs_epi16(_mm256_unpacklo_epi8(A, B), c01), _mm256_maddubs_epi16(_mm256_unpacklo_epi8(C, D), c23));
+    H = _mm256_add_epi16(_mm256_maddubs_epi16(_mm256_unpackhi_epi8(A, B), c01), _mm256_maddubs_epi16(_mm256_unpackhi_epi8(C, D), c23));
+    L = _mm256_srli_epi16(_mm256_add_epi16(L, off), 7);
+    H = _mm256_srli_epi16(_mm256_add_epi16(H, off), 7);
+
+    return _mm256_packus_epi16(L, H);
+}
+
+/* ---------------------------------------------------------------------------
+ * coefficient pairs of the 4-tap filter with the given offset
+ */
+static INLINE void intra_pred_4tap_coef_avx(int offset, __m256i *c01, __m256i *c23)
+{
+    *c01 = _mm256_set1_epi16((short)(((32 + offset) << 8) | offset));
+    *c23 = _mm256_set1_epi16((short)(((32 - offset) << 8) | (64 - offset)));
+}
+
+/* ---------------------------------------------------------------------------
+ * generic prediction of the xy modes 15, 17, 19 and 21, see intra_pred_ang_xy_sse128()
+ */
+void intra_pred_ang_xy_avx(pel_t *src, pel_t *dst, int i_dst, int dir_mode, int bsx, int bsy)
+{
+    static const int8_t tab_xy_odd_dxdy[4][2][2] = {
+        { { 93, 8 }, { 11, 2 } },
+        { { 93, 7 }, { 11, 3 } },
+        { { 11, 3 }, { 93, 7 } },
+        { { 11, 2 }, { 93, 8 } },
+    };
+    ALIGN32(pel_t left_tran[64 * 96]);  /* bsx rows of bsy pixels */
+    ALIGN32(pel_t left[64 * 96]);       /* bsy rows of bsx pixels */
+    ALIGN32(pel_t rsrc[64 + 64 + 64]);
+    ALIGN32(int8_t xsteps[64]);
+    const int8_t (*dxdy)[2] = tab_xy_odd_dxdy[(dir_mode - 15) >> 1];
+    const int i_tran = 96;
+    pel_t *r = rsrc + 64;               /* r[k] = src[-k] */
+    __m256i c01, c23, T, L, mask;
+    int i, j, d, xs, x0, offset;
+
+    if (bsx < 32 || bsy < 32) {
+        intra_pred_ang_xy_sse128(src, dst, i_dst, dir_mode, bsx, bsy);
+        return;
+    }
+
+    memset(rsrc, 0, sizeof(rsrc));
+    for (i = -1; i <= bsy + 1; i++) {
+        r[i] = src[-i];
+    }
+
+    /* left column, predicted along the columns of the block */
+    for (i = 0; i < bsx; i++) {
+        d      = (i + 1) * dxdy[1][0];
+        xs     = d >> dxdy[1][1];
+        offset = ((d << 5) >> dxdy[1][1]) - (xs << 5);
+        xsteps[i] = (int8_t)DAVS2_MIN(xs, 127);
+
+        if (xs < bsy) {
+            pel_t *p = r - xs - 1;
+            intra_pred_4tap_coef_avx(offset, &c01, &c23);
+            for (j = 0; j < bsy; j += 32) {
+                _mm256_storeu_si256((__m256i*)(left_tran + i * i_tran + j), intra_pred_4tap_avx(p + j, c01, c23));
+            }
+        }
+    }
+    intra_pred_transpose_sse128(left_tran, i_tran, left, i_tran, bsx, bsy);
+
+    /* top row, and select the top or the left prediction for each pixel */
+    for (j = 0; j < bsy; j++) {
+        pel_t *p;
+        __m256i row = _mm256_set1_epi8((char)j);
+
+        d      = (j + 1) * dxdy[0][0];
+        x0     = d >> dxdy[0][1];
+        offset = ((d << 5) >> dxdy[0][1]) - (x0 << 5);
+        p      = src - x0 - 1;
+        intra_pred_4tap_coef_avx(offset, &c01, &c23);
+
+        for (i = 0; i < bsx; i += 32) {
+            T    = intra_pred_4tap_avx(p + i, c01, c23);
+            L    = _mm256_loadu_si256((const __m256i*)(left + j * i_tran + i));
+            mask = _mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)(xsteps + i)), row);
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_blendv_epi8(L, T, mask));
+        }
+        dst += i_dst;
+    }
+}
+
 #endif
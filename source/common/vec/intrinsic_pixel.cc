@@ -183,3 +183,76 @@ void plane_copy_c_sse2(pel_t *dst, intptr_t i_dst, pel_t *src, intptr_t i_src, i
         }
     }
 }
+
+#if !HIGH_BIT_DEPTH
+/* ---------------------------------------------------------------------------
+ * 1/2 downscaling of a plane, 16 pixels of dst per loop
+ */
+void plane_downscale_half_sse128(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h)
+{
+    const __m128i c_1 = _mm_set1_epi8(1);
+    const __m128i c_2 = _mm_set1_epi16(2);
+    const int w16 = w & ~15;
+    int i, j;
+
+    for (i = 0; i < h; i++) {
+        const pel_t *s0 = src;
+        const pel_t *s1 = src + i_src;
+
+        for (j = 0; j < w16; j += 16) {
+            __m128i a0 = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s0 + 2 * j     )), c_1);
+            __m128i a1 = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s0 + 2 * j + 16)), c_1);
+            __m128i b0 = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s1 + 2 * j     )), c_1);
+            __m128i b1 = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s1 + 2 * j + 16)), c_1);
+
+            a0 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(a0, b0), c_2), 2);
+            a1 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(a1, b1), c_2), 2);
+            _mm_storeu_si128((__m128i *)(dst + j), _mm_packus_epi16(a0, a1));
+        }
+        for (; j < w; j++) {
+            dst[j] = (pel_t)((s0[2 * j] + s0[2 * j + 1] + s1[2 * j] + s1[2 * j + 1] + 2) >> 2);
+        }
+        dst += i_dst;
+        src += 2 * i_src;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 1/4 downscaling of a plane, 8 pixels of dst per loop
+ */
+void plane_downscale_quarter_sse128(pel_t *dst, intptr_t i_dst, const pel_t *src, intptr_t i_src, int w, int h)
+{
+    const __m128i c_1 = _mm_set1_epi8(1);
+    const __m128i c_8 = _mm_set1_epi16(8);
+    const int w8 = w & ~7;
+    int i, j, k;
+
+    for (i = 0; i < h; i++) {
+        for (j = 0; j < w8; j += 8) {
+            const pel_t *s = src + 4 * j;
+            __m128i sum0 = _mm_setzero_si128();
+            __m128i sum1 = _mm_setzero_si128();
+
+            for (k = 0; k < 4; k++) {
+                sum0 = _mm_add_epi16(sum0, _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s     )), c_1));
+                sum1 = _mm_add_epi16(sum1, _mm_maddubs_epi16(_mm_loadu_si128((const __m128i *)(s + 16)), c_1));
+                s   += i_src;
+            }
+            sum0 = _mm_srli_epi16(_mm_add_epi16(_mm_hadd_epi16(sum0, sum1), c_8), 4);
+            _mm_storel_epi64((__m128i *)(dst + j), _mm_packus_epi16(sum0, sum0));
+        }
+        for (; j < w; j++) {
+            const pel_t *s = src + 4 * j;
+            int sum = 0;
+
+            for (k = 0; k < 4; k++) {
+                sum += s[0] + s[1] + s[2] + s[3];
+                s   += i_src;
+            }
+            dst[j] = (pel_t)((sum + 8) >> 4);
+        }
+        dst += i_dst;
+        src += 4 * i_src;
+    }
+}
+#endif
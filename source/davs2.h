@@ -41,7 +41,7 @@ extern "C" {    // only need to export C interface if used by C++ source code
 
 /* dAVS2 build version, means different API interface
  * (10 * VER_MAJOR + VER_MINOR) */
-#define DAVS2_BUILD                16
+#define DAVS2_BUILD                25
 
 /**
  * ===========================================================================
@@ -118,6 +118,17 @@ enum davs2_ret_e {
     DAVS2_END         = 3,    /* Decoding ended: no more bit-stream to decode and no more frames to output */
 };
 
+/* ---------------------------------------------------------------------------
+ * pictures not decoded (davs2_param_t::skip_frame), they are dropped after
+ * their picture header is parsed and never output
+ */
+enum davs2_skip_frame_e {
+    DAVS2_SKIP_NONE     = 0,  /* decode all pictures */
+    DAVS2_SKIP_NONREF   = 1,  /* skip pictures not referenced by others */
+    DAVS2_SKIP_NONINTRA = 2,  /* decode only intra pictures: I, G and GB */
+    DAVS2_SKIP_NONKEY   = 3,  /* decode only I pictures */
+};
+
 /**
  * ===========================================================================
  * interface struct type defines
@@ -185,9 +196,48 @@ typedef struct davs2_param_t {
                                          0: All; 1: no debug info; 2: only warning and errors; 3: only errors */
     void             *opaque;         /* user data */
     /* additional parameters for version >= 16 */
-    int               disable_avx;    /* 1: disable; 0: default (autodetect) */
+    int               disable_avx;    /* 1: disable AVX; 2: disable all SIMD (C only); 0: default (autodetect).
+                                         process-wide: the first decoder opened sets it, opening a decoder
+                                         with a different value fails */
+    /* additional parameters for version >= 17 */
+    int64_t           max_memory;     /* memory budget (in bytes) of the decoder instance, 0: unlimited.
+                                         the number of parallel frames and the DPB depth are limited to fit in */
+    /* additional parameters for version >= 18 */
+    int               huge_pages;     /* 1: back frame buffers with 2MB huge pages (explicit if reserved, transparent otherwise);
+                                         0: default (system allocator) */
+    int               numa_node;      /* N > 0: pin decoding threads to NUMA node (N - 1) and allocate frame buffers there;
+                                         0: default (no binding). only supported on Linux */
+    /* additional parameters for version >= 19 */
+    void             *group;          /* decoder group (davs2_group_open()) to share threads and frame buffers with,
+                                         NULL: default (own threads). in a group, 'threads' is the number of
+                                         frames of this stream decoded in parallel (0 for 2) */
+    /* additional parameters for version >= 21 */
+    int               skip_frame;     /* pictures not decoded (davs2_skip_frame_e), 0: decode all pictures */
+    /* additional parameters for version >= 22 */
+    int               fast_preview;   /* 1: skip deblocking, SAO and ALF of non-reference pictures (output not bit-exact,
+                                         reference pictures are not affected); 0: default */
+    /* additional parameters for version >= 23 */
+    int               output_scale;   /* size of the output pictures, 1: 1/2, 2: 1/4 (box filtered while copied out,
+                                         reference pictures keep the full resolution); 0: default (full size) */
+    /* additional parameters for version >= 25 */
+    int               error_concealment; /* 1: conceal the corrupted LCUs from the nearest reference (or the LCU row above
+                                         in intra pictures) and resume decoding at the next slice; 0: default (the rest of
+                                         the picture is not decoded). b_decode_error of the picture is set in both cases */
 } davs2_param_t;
 
+/* ---------------------------------------------------------------------------
+ * memory allocated by a decoder instance (in bytes)
+ */
+typedef struct davs2_memory_info_t {
+    int64_t           total;          /* sum of all the categories below */
+    int64_t           budget;         /* memory budget (davs2_param_t::max_memory), 0: unlimited */
+    int64_t           context;        /* decoder handle and frame decoder contexts */
+    int64_t           frames;         /* decoded picture buffer (reference and background frames) */
+    int64_t           task_buffers;   /* per-task buffers for the current resolution (MVs, CU info, ALF/SAO frames) */
+    int64_t           bitstream;      /* buffers for input packets */
+    int64_t           output;         /* output pictures */
+} davs2_memory_info_t;
+
 /**
  * ===========================================================================
  * interface function declares (DAVS2 library APIs for AVS2 video decoder)
@@ -245,7 +295,24 @@ davs2_decoder_flush(void *decoder, davs2_seq_info_t *headerset, davs2_picture_t
 
 /**
  * ---------------------------------------------------------------------------
- * Function   : release one output frame
+ * Function   : reset the decoder for a seek or a discontinuity of the input, instead
+ *              of closing and opening it again. the pictures under decoding are
+ *              finished and dropped along with the ones not output yet, the DPB is
+ *              emptied (its buffers are kept). decoding resumes at the next I picture,
+ *              the following pictures which are not random access decodable are
+ *              dropped. output pictures not released yet remain valid
+ * Parameters :
+ *       [in] : decoder - decoder handle
+ * Return     : none
+ * ---------------------------------------------------------------------------
+ */
+DAVS2_API void
+davs2_decoder_reset(void *decoder);
+
+/**
+ * ---------------------------------------------------------------------------
+ * Function   : release one output frame. up to 16 output frames can be held by
+ *              the application at a time, holding more may stall the decoding
  * Parameters :
  *       [in] : decoder   - decoder handle
  *            : out_frame - frame to recycle
@@ -255,6 +322,62 @@ davs2_decoder_flush(void *decoder, davs2_seq_info_t *headerset, davs2_picture_t
 DAVS2_API void
 davs2_decoder_frame_unref(void *decoder, davs2_picture_t *out_frame);
 
+/**
+ * ---------------------------------------------------------------------------
+ * Function   : get the memory allocated by the decoder
+ * Parameters :
+ *       [in] : decoder   - decoder handle
+ *      [out] : info      - memory usage of each category
+ * Return     : 0 for success, -1 for failure
+ * ---------------------------------------------------------------------------
+ */
+DAVS2_API int
+davs2_decoder_get_memory_info(void *decoder, davs2_memory_info_t *info);
+
+/**
+ * ---------------------------------------------------------------------------
+ * Function   : open a decoder group. decoders opened with the group handle
+ *              (davs2_param_t::group) share one thread pool, in which the frames
+ *              of all the streams are decoded in submission order, and reuse
+ *              the frame buffers released by each other
+ * Parameters :
+ *       [in] : threads - number of threads in the shared pool, 0 for auto
+ * Return     : handle of the group, zero for failure
+ * ---------------------------------------------------------------------------
+ */
+DAVS2_API void *
+davs2_group_open(int threads);
+
+/**
+ * ---------------------------------------------------------------------------
+ * Function   : close a decoder group, the group is destroyed after all the
+ *              decoders in it are closed
+ * Parameters :
+ *       [in] : group - group handle
+ * Return     : none
+ * ---------------------------------------------------------------------------
+ */
+DAVS2_API void
+davs2_group_close(void *group);
+
+/**
+ * ---------------------------------------------------------------------------
+ * Function   : find the points where a bitstream can be split into segments
+ *              which are decoded independently (e.g. on several decoders in
+ *              parallel, the outputs are then concatenated in order). a point
+ *              is a sequence header followed by an I picture, where all the
+ *              pictures up to the next I picture are random access decodable
+ * Parameters :
+ *       [in] : data        - bitstream
+ *       [in] : len         - bytes of the bitstream
+ *      [out] : offsets     - byte offsets of the points (start codes of the sequence headers)
+ *       [in] : max_offsets - max number of points to be stored in offsets
+ * Return     : number of points found
+ * ---------------------------------------------------------------------------
+ */
+DAVS2_API int
+davs2_find_split_points(const uint8_t *data, int len, int *offsets, int max_offsets);
+
 /**
  * ---------------------------------------------------------------------------
  * Function   : close the AVS2 decoder
@@ -0,0 +1,246 @@
+/*
+ * bench.h
+ *
+ * Description of this file:
+ *    Benchmark statistics (throughput, latency and resources) of the davs2 test application
+ *
+ * --------------------------------------------------------------------------
+ *
+ *    davs2 - video decoder of AVS2/IEEE1857.4 video coding standard
+ *    Copyright (C) 2018~ VCL, NELVT, Peking University
+ *
+ *    Authors: Falei LUO <falei.luo@gmail.com>
+ *             etc.
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation; either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02111, USA.
+ *
+ *    This program is also available under a commercial proprietary license.
+ *    For more information, contact us at sswang @ pku.edu.cn.
+ */
+
+#ifndef DAVS2_BENCH_H
+#define DAVS2_BENCH_H
+
+#include "utils.h"
+
+#include <string.h>
+
+#if _WIN32
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+/* ---------------------------------------------------------------------------
+ * benchmark statistics of one run
+ */
+typedef struct bench_t {
+    int       b_enabled;
+    int64_t   time_start;       /* time the decoding started (get_time()) */
+    int64_t  *send_times;       /* time each packet was sent, indexed by its pts */
+    int       num_sent;
+    int       max_sent;
+    double   *latencies;        /* latency (ms) of each output frame: from sending its packet to getting the frame */
+    int       num_frames;
+    int       max_frames;
+    int       width;            /* format of the output frames */
+    int       height;
+    int       bit_depth;
+} bench_t;
+
+/* ---------------------------------------------------------------------------
+ * time in ms from get_time() ticks
+ */
+static __inline double bench_ms(int64_t ticks)
+{
+    return ticks * 1000.0 / CLOCKS_PER_SEC;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void bench_open(bench_t *b, int b_enabled)
+{
+    memset(b, 0, sizeof(bench_t));
+    b->b_enabled  = b_enabled;
+    b->time_start = get_time();
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void bench_close(bench_t *b)
+{
+    free(b->send_times);
+    free(b->latencies);
+    memset(b, 0, sizeof(bench_t));
+}
+
+/* ---------------------------------------------------------------------------
+ * append one value to a growing array, returns 0 on success
+ */
+static int bench_grow(void **p_array, int *p_max, int num, size_t size_item)
+{
+    if (num >= *p_max) {
+        int   max_new = *p_max ? *p_max * 2 : 1024;
+        void *p_new   = realloc(*p_array, max_new * size_item);
+
+        if (p_new == NULL) {
+            return -1;
+        }
+        *p_array = p_new;
+        *p_max   = max_new;
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * record the packet with the given pts (0, 1, 2, ...) sent to the decoder
+ */
+static void bench_packet_sent(bench_t *b, int64_t pts)
+{
+    if (!b->b_enabled || pts != b->num_sent ||
+        bench_grow((void **)&b->send_times, &b->max_sent, b->num_sent, sizeof(int64_t)) < 0) {
+        return;
+    }
+    b->send_times[b->num_sent++] = get_time();
+}
+
+/* ---------------------------------------------------------------------------
+ * record one picture returned by the decoder
+ */
+static void bench_frame_out(bench_t *b, davs2_picture_t *pic)
+{
+    if (!b->b_enabled || pic->pts < 0 || pic->pts >= b->num_sent ||
+        bench_grow((void **)&b->latencies, &b->max_frames, b->num_frames, sizeof(double)) < 0) {
+        return;
+    }
+    if (b->num_frames == 0) {
+        b->width     = pic->widths[0];
+        b->height    = pic->lines[0];
+        b->bit_depth = pic->bit_depth;
+    }
+    b->latencies[b->num_frames++] = bench_ms(get_time() - b->send_times[pic->pts]);
+}
+
+/* ---------------------------------------------------------------------------
+ * CPU time (user and system, in seconds) and peak resident memory (in KB) of the process
+ */
+static void bench_get_usage(double *cpu_time, int64_t *peak_rss)
+{
+#if _WIN32
+    FILETIME t_create, t_exit, t_kernel, t_user;
+    PROCESS_MEMORY_COUNTERS pmc;
+    ULARGE_INTEGER k, u;
+
+    *cpu_time = 0;
+    *peak_rss = 0;
+    if (GetProcessTimes(GetCurrentProcess(), &t_create, &t_exit, &t_kernel, &t_user)) {
+        k.LowPart  = t_kernel.dwLowDateTime;
+        k.HighPart = t_kernel.dwHighDateTime;
+        u.LowPart  = t_user.dwLowDateTime;
+        u.HighPart = t_user.dwHighDateTime;
+        *cpu_time  = (double)(k.QuadPart + u.QuadPart) * 1e-7;    /* 100 ns units */
+    }
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        *peak_rss = (int64_t)(pmc.PeakWorkingSetSize >> 10);
+    }
+#else
+    struct rusage ru;
+
+    *cpu_time = 0;
+    *peak_rss = 0;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        *cpu_time = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+#if defined(__APPLE__)
+        *peak_rss = (int64_t)ru.ru_maxrss >> 10;                   /* in bytes */
+#else
+        *peak_rss = (int64_t)ru.ru_maxrss;                         /* in KB */
+#endif
+    }
+#endif
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double d = *(const double *)a - *(const double *)b;
+    return (d > 0) - (d < 0);
+}
+
+/* ---------------------------------------------------------------------------
+ * latency percentile (nearest rank) of the sorted latencies
+ */
+static double bench_percentile(bench_t *b, int percent)
+{
+    int rank = (b->num_frames * percent + 99) / 100;
+
+    if (b->num_frames == 0) {
+        return 0;
+    }
+    return b->latencies[rank > 0 ? rank - 1 : 0];
+}
+
+/* ---------------------------------------------------------------------------
+ * append the statistics of this run to a file as one JSON object per line,
+ * so that the results of several runs (threads, CPU levels, streams) can be
+ * collected in one file and compared between builds
+ */
+static int bench_report(bench_t *b, const char *s_file, const char *s_stream,
+                        int threads, int cpu_level, int segments, int total_frames)
+{
+    const char *s_cpu[3] = { "auto", "noavx", "c" };
+    int64_t  time_end = get_time();
+    double   seconds  = bench_ms(time_end - b->time_start) / 1000.0;
+    double   cpu_time;
+    int64_t  peak_rss;
+    FILE    *fp;
+    const char *p;
+
+    bench_get_usage(&cpu_time, &peak_rss);
+    qsort(b->latencies, b->num_frames, sizeof(double), bench_cmp_double);
+
+    if ((fp = fopen(s_file, "a")) == NULL) {
+        return -1;
+    }
+
+    /* the stream name is escaped for JSON */
+    fprintf(fp, "{\"stream\": \"");
+    for (p = s_stream; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fputc('\\', fp);
+        }
+        fputc(*p, fp);
+    }
+    fprintf(fp, "\", \"build\": %d, \"threads\": %d, \"cpu\": \"%s\", \"segments\": %d, ",
+            DAVS2_BUILD, threads, s_cpu[(cpu_level < 0 || cpu_level > 2) ? 0 : cpu_level], segments);
+    fprintf(fp, "\"width\": %d, \"height\": %d, \"bit_depth\": %d, \"frames\": %d, ",
+            b->width, b->height, b->bit_depth, total_frames);
+    fprintf(fp, "\"time_s\": %.3f, \"fps\": %.2f, ",
+            seconds, seconds > 0 ? total_frames / seconds : 0.0);
+    fprintf(fp, "\"latency_ms\": {\"frames\": %d, \"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}, ",
+            b->num_frames, bench_percentile(b, 0), bench_percentile(b, 50), bench_percentile(b, 90),
+            bench_percentile(b, 99), bench_percentile(b, 100));
+    fprintf(fp, "\"peak_rss_kb\": %lld, \"cpu_time_s\": %.3f, \"cpu_utilization\": %.2f}\n",
+            (long long)peak_rss, cpu_time, seconds > 0 ? cpu_time / seconds : 0.0);
+
+    fclose(fp);
+    return 0;
+}
+
+#endif /// DAVS2_BENCH_H
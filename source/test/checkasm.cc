@@ -0,0 +1,1085 @@
+/*
+ * checkasm.cc
+ *
+ * Description of this file:
+ *    Check of the SIMD function handles against the C ones, with timings
+ *
+ * --------------------------------------------------------------------------
+ *
+ *    davs2 - video decoder of AVS2/IEEE1857.4 video coding standard
+ *    Copyright (C) 2018~ VCL, NELVT, Peking University
+ *
+ *    Authors: Falei LUO <falei.luo@gmail.com>
+ *             etc.
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation; either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02111, USA.
+ *
+ *    This program is also available under a commercial proprietary license.
+ *    For more information, contact us at sswang @ pku.edu.cn.
+ */
+
+#include "common/common.h"
+#include "common/primitives.h"
+#include "common/cpu.h"
+#include "common/intra.h"
+#include "common/mc.h"
+#include "common/transform.h"
+#include "common/quant.h"
+#include "common/deblock.h"
+#include "common/sao.h"
+#include "common/alf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if ARCH_X86 || ARCH_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/**
+ * ===========================================================================
+ * primitive check
+ *
+ * every function handle installed for a CPU tier is compared against its C
+ * reference on random inputs for all block sizes the decoder uses, and both
+ * are timed in CPU cycles. Only handles that are changed by a tier are
+ * checked for it.
+ * The edge emulation of motion compensation is compared against padded
+ * reference pictures as well.
+ * ===========================================================================
+ */
+#define CHECK_NUM_RUNS      8     /* random inputs per function and block size */
+#define CHECK_BENCH_RUNS    32    /* timed calls per function and block size */
+#define CHECK_STRIDE        160   /* stride of the pixel buffers */
+#define CHECK_OFFSET        (32 * CHECK_STRIDE + 32)    /* position of the block in the pixel buffers */
+
+/* ---------------------------------------------------------------------------
+ * buffers, the block under test starts at CHECK_OFFSET of the pixel buffers
+ */
+typedef struct check_buf_t {
+    ALIGN32(pel_t   src [CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(pel_t   src2[CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(pel_t   ref [CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(pel_t   opt [CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(pel_t   ref2[CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(pel_t   opt2[CHECK_STRIDE * CHECK_STRIDE]);
+    ALIGN32(coeff_t coef    [MAX_CU_SIZE * MAX_CU_SIZE]);
+    ALIGN32(coeff_t coef_ref[MAX_CU_SIZE * MAX_CU_SIZE]);
+    ALIGN32(coeff_t coef_opt[MAX_CU_SIZE * MAX_CU_SIZE]);
+} check_buf_t;
+
+/* ---------------------------------------------------------------------------
+ * state of the check
+ */
+typedef struct check_t {
+    const ao_funcs_t *ref;          /* C functions */
+    const ao_funcs_t *opt;          /* functions of the tier under test */
+    const ao_funcs_t *prev;         /* functions of the previous tier */
+    const char       *tier;         /* name of the tier under test */
+    check_buf_t      *buf;
+    uint32_t          seed;         /* state of the random generator */
+    int               num_checked;
+    int               num_failed;
+} check_t;
+
+/* ---------------------------------------------------------------------------
+ * CPU tiers, each one includes the flags of the tiers before it
+ */
+static const struct {
+    const char *name;
+    uint32_t    flags;
+} CHECK_TIERS[] = {
+#if ARCH_X86 || ARCH_X86_64
+    { "SSE2",  DAVS2_CPU_MMX | DAVS2_CPU_MMX2 | DAVS2_CPU_SSE | DAVS2_CPU_SSE2 },
+    { "SSSE3", DAVS2_CPU_SSE3 | DAVS2_CPU_SSSE3 },
+    { "SSE4",  DAVS2_CPU_SSE4 | DAVS2_CPU_SSE42 },
+    { "AVX",   DAVS2_CPU_AVX },
+    { "AVX2",  DAVS2_CPU_AVX2 | DAVS2_CPU_FMA3 | DAVS2_CPU_BMI1 | DAVS2_CPU_BMI2 | DAVS2_CPU_LZCNT },
+#else
+    { "asm",   0xFFFFFFFF },
+#endif
+};
+
+/* ---------------------------------------------------------------------------
+ * width and height of the partitions (in order of enum PU_PART)
+ */
+static const uint8_t CHECK_PART_SIZE[MAX_PART_NUM][2] = {
+    {  4,  4 }, {  8,  8 }, { 16, 16 }, { 32, 32 }, { 64, 64 },
+    {  8,  4 }, {  4,  8 },
+    { 16,  8 }, {  8, 16 },
+    { 32, 16 }, { 16, 32 },
+    { 64, 32 }, { 32, 64 },
+    { 16, 12 }, { 12, 16 }, { 16,  4 }, {  4, 16 },
+    { 32, 24 }, { 24, 32 }, { 32,  8 }, {  8, 32 },
+    { 64, 48 }, { 48, 64 }, { 64, 16 }, { 16, 64 },
+};
+
+/* ---------------------------------------------------------------------------
+ * sizes of intra prediction and transform blocks (SDIP is only used in 32x32
+ * and 16x16 CUs)
+ */
+static const uint8_t CHECK_BLOCK_SIZE[][2] = {
+    {  4,  4 }, {  8,  8 }, { 16, 16 }, { 32, 32 }, { 64, 64 },
+    { 16,  4 }, {  4, 16 }, { 32,  8 }, {  8, 32 },
+};
+
+/* ---------------------------------------------------------------------------
+ * interpolation filters, the same as in mc.cc
+ */
+static const int8_t CHECK_INTPL_FILTERS[4][8] = {
+    {  0, 0,   0, 64,  0,  0,  0,  0 },
+    { -1, 4, -10, 57, 19, -7,  3, -1 },
+    { -1, 4, -11, 40, 40, -11, 4, -1 },
+    { -1, 3,  -7, 19, 57, -10, 4, -1 }
+};
+
+static const int8_t CHECK_INTPL_FILTERS_C[8][4] = {
+    {  0, 64,  0,  0 },
+    { -4, 62,  6,  0 },
+    { -6, 56, 15, -1 },
+    { -5, 47, 25, -3 },
+    { -4, 36, 36, -4 },
+    { -3, 25, 47, -5 },
+    { -1, 15, 56, -6 },
+    {  0,  6, 62, -4 }
+};
+
+/* ---------------------------------------------------------------------------
+ * time stamp counter, microseconds where there is no cycle counter
+ */
+#if ARCH_X86 || ARCH_X86_64
+#define CHECK_TIME_UNIT     "cycles"
+static INLINE int64_t check_timer(void)
+{
+    return (int64_t)__rdtsc();
+}
+#else
+#define CHECK_TIME_UNIT     "us"
+static INLINE int64_t check_timer(void)
+{
+    return davs2_get_us();
+}
+#endif
+
+/* ---------------------------------------------------------------------------
+ * run both functions on the same random inputs and compare the first
+ * size_result bytes of their results, then time them
+ */
+#define CHECK_RUN_N(b_ok, time_ref, time_opt, setup, call_ref, call_opt, result_ref, result_opt, size_result) \
+    {\
+        int64_t t0_;\
+        int run_;\
+        for (run_ = 0; run_ < CHECK_NUM_RUNS; run_++) {\
+            setup;\
+            call_ref;\
+            call_opt;\
+            b_ok &= !memcmp(result_ref, result_opt, size_result);\
+        }\
+        t0_ = check_timer();\
+        for (run_ = 0; run_ < CHECK_BENCH_RUNS; run_++) {\
+            call_ref;\
+        }\
+        time_ref += check_timer() - t0_;\
+        t0_ = check_timer();\
+        for (run_ = 0; run_ < CHECK_BENCH_RUNS; run_++) {\
+            call_opt;\
+        }\
+        time_opt += check_timer() - t0_;\
+    }
+
+/* ---------------------------------------------------------------------------
+ * the same as CHECK_RUN_N, the results are compared over their full buffers
+ */
+#define CHECK_RUN(b_ok, time_ref, time_opt, setup, call_ref, call_opt, result_ref, result_opt) \
+    CHECK_RUN_N(b_ok, time_ref, time_opt, setup, call_ref, call_opt, result_ref, result_opt, sizeof(result_ref))
+
+/* ---------------------------------------------------------------------------
+ * a function handle is checked for the tier which has changed it
+ */
+#define CHECK_FUNC(c, name)     ((c)->opt->name != (c)->ref->name && (c)->opt->name != (c)->prev->name)
+
+/* ---------------------------------------------------------------------------
+ */
+static INLINE int check_rand(check_t *c)
+{
+    c->seed = c->seed * 1664525 + 1013904223;
+    return (int)(c->seed >> 8);
+}
+
+/* ---------------------------------------------------------------------------
+ * random value in [min_val, max_val]
+ */
+static INLINE int check_rand_range(check_t *c, int min_val, int max_val)
+{
+    return min_val + check_rand(c) % (max_val - min_val + 1);
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void check_fill_pel(check_t *c, pel_t *p, int num)
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        p[i] = (pel_t)(check_rand(c) & max_pel_value);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * smooth pixels, so that the loop filters are not always switched off
+ */
+static void check_fill_pel_smooth(check_t *c, pel_t *p, int num, int range)
+{
+    int base = check_rand_range(c, range, max_pel_value - range);
+    int i;
+
+    for (i = 0; i < num; i++) {
+        p[i] = (pel_t)(base + check_rand_range(c, -range, range));
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void check_fill_coef(check_t *c, coeff_t *p, int num, int max_abs)
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        p[i] = (coeff_t)check_rand_range(c, -max_abs, max_abs);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * set the two destination buffers to the same content before a call
+ */
+static void check_reset_dst(check_t *c)
+{
+    check_buf_t *b = c->buf;
+
+    check_fill_pel(c, b->ref, CHECK_STRIDE * CHECK_STRIDE);
+    memcpy(b->opt, b->ref, sizeof(b->ref));
+    check_fill_pel(c, b->ref2, CHECK_STRIDE * CHECK_STRIDE);
+    memcpy(b->opt2, b->ref2, sizeof(b->ref2));
+}
+
+/* ---------------------------------------------------------------------------
+ * extend the reference samples of a bsx x bsy block beyond the top-right and
+ * the left-down ends, the same way as fill_reference_samples() does
+ */
+static void check_pad_edge(pel_t *EP, int bsx, int bsy)
+{
+    int num_padding_r = DAVS2_MAX(bsy * 11 / 4 - bsx + 4, 0);
+    int num_padding_l = DAVS2_MAX(bsx * 11 / 4 - bsy + 4, 0);
+    int i;
+
+    for (i = 1; i <= num_padding_r; i++) {
+        EP[2 * bsx + i] = EP[2 * bsx];
+    }
+    for (i = 1; i <= num_padding_l; i++) {
+        EP[-2 * bsy - i] = EP[-2 * bsy];
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void check_report(check_t *c, const char *name, int idx0, int idx1, int b_ok, int64_t time_ref, int64_t time_opt)
+{
+    char s_name[64];
+
+    if (idx1 >= 0) {
+        sprintf(s_name, "%s[%d][%d]", name, idx0, idx1);
+    } else if (idx0 >= 0) {
+        sprintf(s_name, "%s[%d]", name, idx0);
+    } else {
+        sprintf(s_name, "%s", name);
+    }
+
+    c->num_checked++;
+    if (!b_ok) {
+        c->num_failed++;
+    }
+    printf("%-5s %-26s %-8s %10.1f -> %10.1f %s (x%.2f)\n",
+           c->tier, s_name, b_ok ? "ok" : "MISMATCH",
+           (double)time_ref / CHECK_BENCH_RUNS, (double)time_opt / CHECK_BENCH_RUNS, CHECK_TIME_UNIT,
+           time_opt > 0 ? (double)time_ref / time_opt : 0.0);
+}
+
+/* ---------------------------------------------------------------------------
+ * block copy, average and reconstruction
+ */
+static void check_pixel(check_t *c)
+{
+    check_buf_t *b = c->buf;
+    const int i_buf = CHECK_STRIDE;
+    pel_t *src  = b->src  + CHECK_OFFSET;
+    pel_t *src2 = b->src2 + CHECK_OFFSET;
+    pel_t *ref  = b->ref  + CHECK_OFFSET;
+    pel_t *opt  = b->opt  + CHECK_OFFSET;
+    int64_t avg_ref = 0, avg_opt = 0, copy_ref = 0, copy_opt = 0;
+    int b_avg_ok = 1, b_copy_ok = 1;
+    int part, chroma;
+
+    for (part = 0; part < MAX_PART_NUM; part++) {
+        int w = CHECK_PART_SIZE[part][0];
+        int h = CHECK_PART_SIZE[part][1];
+
+        if (CHECK_FUNC(c, copy_pp[part])) {
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                      c->ref->copy_pp[part](ref, i_buf, src, i_buf),
+                      c->opt->copy_pp[part](opt, i_buf, src, i_buf),
+                      b->ref, b->opt);
+            check_report(c, "copy_pp", part, -1, b_ok, time_ref, time_opt);
+        }
+
+        if (CHECK_FUNC(c, add_ps[part])) {
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE);
+                      check_fill_coef(c, b->coef, w * h, max_pel_value + 1); check_reset_dst(c),
+                      c->ref->add_ps[part](ref, i_buf, src, b->coef, i_buf, w),
+                      c->opt->add_ps[part](opt, i_buf, src, b->coef, i_buf, w),
+                      b->ref, b->opt);
+            check_report(c, "add_ps", part, -1, b_ok, time_ref, time_opt);
+        }
+
+        /* luma and chroma prediction blocks */
+        for (chroma = 0; chroma < 2; chroma++) {
+            int w_pu = w >> chroma;
+            int h_pu = h >> chroma;
+
+            if (CHECK_FUNC(c, block_avg)) {
+                CHECK_RUN(b_avg_ok, avg_ref, avg_opt,
+                          check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE);
+                          check_fill_pel(c, b->src2, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                          c->ref->block_avg(ref, i_buf, src, i_buf, src2, i_buf, w_pu, h_pu),
+                          c->opt->block_avg(opt, i_buf, src, i_buf, src2, i_buf, w_pu, h_pu),
+                          b->ref, b->opt);
+            }
+
+            if (CHECK_FUNC(c, block_copy)) {
+                CHECK_RUN(b_copy_ok, copy_ref, copy_opt,
+                          check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                          c->ref->block_copy(ref, i_buf, src, i_buf, w_pu, h_pu),
+                          c->opt->block_copy(opt, i_buf, src, i_buf, w_pu, h_pu),
+                          b->ref, b->opt);
+            }
+        }
+    }
+
+    if (CHECK_FUNC(c, block_avg)) {
+        check_report(c, "block_avg", -1, -1, b_avg_ok, avg_ref, avg_opt);
+    }
+    if (CHECK_FUNC(c, block_copy)) {
+        check_report(c, "block_copy", -1, -1, b_copy_ok, copy_ref, copy_opt);
+    }
+
+    /* output downscaling, the sizes of dst are not multiples of the SIMD width */
+    for (part = 0; part < 2; part++) {
+        const int sizes[2][2] = { { 120, 120 }, { 76, 44 } };
+
+        if (CHECK_FUNC(c, plane_downscale[part])) {
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+            int k;
+
+            for (k = 0; k < 2; k++) {
+                int w = sizes[k][0] >> (part + 1);
+                int h = sizes[k][1] >> (part + 1);
+
+                CHECK_RUN(b_ok, time_ref, time_opt,
+                          check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                          c->ref->plane_downscale[part](ref, i_buf, src, i_buf, w, h),
+                          c->opt->plane_downscale[part](opt, i_buf, src, i_buf, w, h),
+                          b->ref, b->opt);
+            }
+            check_report(c, "plane_downscale", part, -1, b_ok, time_ref, time_opt);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * interpolation of luma and chroma prediction blocks
+ */
+static void check_mc(check_t *c)
+{
+    check_buf_t *b = c->buf;
+    const int i_buf = CHECK_STRIDE;
+    pel_t *src = b->src + CHECK_OFFSET;
+    pel_t *ref = b->ref + CHECK_OFFSET;
+    pel_t *opt = b->opt + CHECK_OFFSET;
+    int idx, k, part;
+
+    for (idx = 0; idx < 2; idx++) {
+        int64_t ver_ref[3] = { 0 }, ver_opt[3] = { 0 }, hor_ref[3] = { 0 }, hor_opt[3] = { 0 };
+        int64_t ext_ref = 0, ext_opt = 0;
+        int b_ver_ok[3] = { 1, 1, 1 }, b_hor_ok[3] = { 1, 1, 1 }, b_ext_ok = 1;
+        int64_t ver_ref_c = 0, ver_opt_c = 0, hor_ref_c = 0, hor_opt_c = 0;
+        int64_t ext_ref_c = 0, ext_opt_c = 0;
+        int b_ver_ok_c = 1, b_hor_ok_c = 1, b_ext_ok_c = 1;
+
+        for (part = 0; part < MAX_PART_NUM; part++) {
+            int w = CHECK_PART_SIZE[part][0];
+            int h = CHECK_PART_SIZE[part][1];
+
+            /* luma */
+            if (MC_PART_INDEX(w, h) == idx) {
+                for (k = 0; k < 3; k++) {
+                    const int8_t *coeff = CHECK_INTPL_FILTERS[k + 1];
+
+                    if (CHECK_FUNC(c, intpl_luma_ver[idx][k])) {
+                        CHECK_RUN(b_ver_ok[k], ver_ref[k], ver_opt[k],
+                                  check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                                  c->ref->intpl_luma_ver[idx][k](ref, i_buf, src, i_buf, w, h, coeff),
+                                  c->opt->intpl_luma_ver[idx][k](opt, i_buf, src, i_buf, w, h, coeff),
+                                  b->ref, b->opt);
+                    }
+                    if (CHECK_FUNC(c, intpl_luma_hor[idx][k])) {
+                        CHECK_RUN(b_hor_ok[k], hor_ref[k], hor_opt[k],
+                                  check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                                  c->ref->intpl_luma_hor[idx][k](ref, i_buf, src, i_buf, w, h, coeff),
+                                  c->opt->intpl_luma_hor[idx][k](opt, i_buf, src, i_buf, w, h, coeff),
+                                  b->ref, b->opt);
+                    }
+                }
+
+                if (CHECK_FUNC(c, intpl_luma_ext[idx])) {
+                    int dx = 0, dy = 0;
+                    CHECK_RUN(b_ext_ok, ext_ref, ext_opt,
+                              dx = check_rand_range(c, 1, 3); dy = check_rand_range(c, 1, 3);
+                              check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                              c->ref->intpl_luma_ext[idx](ref, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS[dx], CHECK_INTPL_FILTERS[dy]),
+                              c->opt->intpl_luma_ext[idx](opt, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS[dx], CHECK_INTPL_FILTERS[dy]),
+                              b->ref, b->opt);
+                }
+            }
+
+            /* chroma */
+            w >>= 1;
+            h >>= 1;
+            if (MC_PART_INDEX(w, h) == idx) {
+                int dx = 0, dy = 0;
+
+                if (CHECK_FUNC(c, intpl_chroma_ver[idx])) {
+                    CHECK_RUN(b_ver_ok_c, ver_ref_c, ver_opt_c,
+                              dy = check_rand_range(c, 1, 7);
+                              check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                              c->ref->intpl_chroma_ver[idx](ref, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dy]),
+                              c->opt->intpl_chroma_ver[idx](opt, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dy]),
+                              b->ref, b->opt);
+                }
+                if (CHECK_FUNC(c, intpl_chroma_hor[idx])) {
+                    CHECK_RUN(b_hor_ok_c, hor_ref_c, hor_opt_c,
+                              dx = check_rand_range(c, 1, 7);
+                              check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                              c->ref->intpl_chroma_hor[idx](ref, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dx]),
+                              c->opt->intpl_chroma_hor[idx](opt, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dx]),
+                              b->ref, b->opt);
+                }
+                if (CHECK_FUNC(c, intpl_chroma_ext[idx])) {
+                    CHECK_RUN(b_ext_ok_c, ext_ref_c, ext_opt_c,
+                              dx = check_rand_range(c, 1, 7); dy = check_rand_range(c, 1, 7);
+                              check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                              c->ref->intpl_chroma_ext[idx](ref, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dx], CHECK_INTPL_FILTERS_C[dy]),
+                              c->opt->intpl_chroma_ext[idx](opt, i_buf, src, i_buf, w, h, CHECK_INTPL_FILTERS_C[dx], CHECK_INTPL_FILTERS_C[dy]),
+                              b->ref, b->opt);
+                }
+            }
+        }
+
+        for (k = 0; k < 3; k++) {
+            if (CHECK_FUNC(c, intpl_luma_ver[idx][k])) {
+                check_report(c, "intpl_luma_ver", idx, k, b_ver_ok[k], ver_ref[k], ver_opt[k]);
+            }
+            if (CHECK_FUNC(c, intpl_luma_hor[idx][k])) {
+                check_report(c, "intpl_luma_hor", idx, k, b_hor_ok[k], hor_ref[k], hor_opt[k]);
+            }
+        }
+        if (CHECK_FUNC(c, intpl_luma_ext[idx])) {
+            check_report(c, "intpl_luma_ext", idx, -1, b_ext_ok, ext_ref, ext_opt);
+        }
+        if (CHECK_FUNC(c, intpl_chroma_ver[idx])) {
+            check_report(c, "intpl_chroma_ver", idx, -1, b_ver_ok_c, ver_ref_c, ver_opt_c);
+        }
+        if (CHECK_FUNC(c, intpl_chroma_hor[idx])) {
+            check_report(c, "intpl_chroma_hor", idx, -1, b_hor_ok_c, hor_ref_c, hor_opt_c);
+        }
+        if (CHECK_FUNC(c, intpl_chroma_ext[idx])) {
+            check_report(c, "intpl_chroma_ext", idx, -1, b_ext_ok_c, ext_ref_c, ext_opt_c);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * intra prediction and filling of the reference samples
+ */
+static void check_intra(check_t *c)
+{
+    check_buf_t *b = c->buf;
+    const int i_buf = CHECK_STRIDE;
+    const int num_sizes = sizeof(CHECK_BLOCK_SIZE) / sizeof(CHECK_BLOCK_SIZE[0]);
+    pel_t *EP  = b->src + (MAX_CU_SIZE << 2) - 1;    /* the same layout as buf_edge_pixels */
+    pel_t *ref = b->ref + CHECK_OFFSET;
+    pel_t *opt = b->opt + CHECK_OFFSET;
+    int mode, i;
+
+    for (mode = 0; mode < NUM_INTRA_MODE; mode++) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+
+        if (!CHECK_FUNC(c, intraf[mode])) {
+            continue;
+        }
+
+        for (i = 0; i < num_sizes; i++) {
+            int bsx = CHECK_BLOCK_SIZE[i][0];
+            int bsy = CHECK_BLOCK_SIZE[i][1];
+            int dir_mode = mode;
+
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_pel(c, b->src, MAX_CU_SIZE << 3); check_pad_edge(EP, bsx, bsy); check_reset_dst(c);
+                      if (mode == DC_PRED) { dir_mode = ((check_rand(c) & 1) << 8) + (check_rand(c) & 1); },
+                      c->ref->intraf[mode](EP, ref, i_buf, dir_mode, bsx, bsy),
+                      c->opt->intraf[mode](EP, opt, i_buf, dir_mode, bsx, bsy),
+                      b->ref, b->opt);
+        }
+        check_report(c, "intraf", mode, -1, b_ok, time_ref, time_opt);
+    }
+
+    for (mode = 0; mode < 4; mode++) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        pel_t *p_tl     = b->src + CHECK_OFFSET - i_buf - 1;
+        pel_t *p_lcu_ep = b->src2 + (CHECK_STRIDE * CHECK_STRIDE >> 1);
+        pel_t *EP_ref   = b->ref + (MAX_CU_SIZE << 2) - 1;
+        pel_t *EP_opt   = b->opt + (MAX_CU_SIZE << 2) - 1;
+
+        if (!CHECK_FUNC(c, fill_edge_f[mode])) {
+            continue;
+        }
+
+        for (i = 0; i < num_sizes; i++) {
+            int bsx = CHECK_BLOCK_SIZE[i][0];
+            int bsy = CHECK_BLOCK_SIZE[i][1];
+            int num_padding_l = DAVS2_MAX(bsx * 11 / 4 - bsy + 4, 0);
+            int num_padding_r = DAVS2_MAX(bsy * 11 / 4 - bsx + 4, 0);
+            int size_ep = (2 * bsx + 2 * bsy + 1 + num_padding_l + num_padding_r) * sizeof(pel_t);
+            uint32_t avail = 0;
+
+            /* only the reference samples and their padding are compared */
+            CHECK_RUN_N(b_ok, time_ref, time_opt,
+                      check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE);
+                      check_fill_pel(c, b->src2, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c);
+                      avail = (uint32_t)check_rand(c) & ((1 << MD_I_NUM) - 1),
+                      c->ref->fill_edge_f[mode](p_tl, i_buf, p_lcu_ep, EP_ref, avail, bsx, bsy),
+                      c->opt->fill_edge_f[mode](p_tl, i_buf, p_lcu_ep, EP_opt, avail, bsx, bsy),
+                      EP_ref - 2 * bsy - num_padding_l, EP_opt - 2 * bsy - num_padding_l, size_ep);
+        }
+        check_report(c, "fill_edge_f", mode, -1, b_ok, time_ref, time_opt);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * inverse transforms and dequantization
+ */
+static void check_transform(check_t *c)
+{
+    check_buf_t *b = c->buf;
+    int part, pattern;
+
+    for (part = 0; part < MAX_PART_NUM; part++) {
+        int w = CHECK_PART_SIZE[part][0];
+        int h = CHECK_PART_SIZE[part][1];
+        /* blocks of size 64 are coded by a wavelet with half the coefficients in each direction */
+        int b_wavelet = (w == 64 || h == 64);
+        int i_coeff = w >> b_wavelet;
+        int h_coeff = h >> b_wavelet;
+
+        for (pattern = 0; pattern < DCT_PATTERN_NUM; pattern++) {
+            /* area of the non-zero coefficients */
+            int w_nz = pattern == DCT_DC ? 1 : i_coeff >> pattern;
+            int h_nz = pattern == DCT_DC ? 1 : h_coeff >> pattern;
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+            int y;
+
+            if (c->ref->idct[part][pattern] == NULL || !CHECK_FUNC(c, idct[part][pattern])) {
+                continue;
+            }
+
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      memset(b->coef_ref, 0, sizeof(b->coef_ref));
+                      for (y = 0; y < h_nz; y++) { check_fill_coef(c, b->coef_ref + y * i_coeff, w_nz, 2047); }
+                      memcpy(b->coef_opt, b->coef_ref, sizeof(b->coef_ref)),
+                      c->ref->idct[part][pattern](b->coef_ref, b->coef_ref, i_coeff),
+                      c->opt->idct[part][pattern](b->coef_opt, b->coef_opt, i_coeff),
+                      b->coef_ref, b->coef_opt);
+            check_report(c, "idct", part, pattern, b_ok, time_ref, time_opt);
+        }
+    }
+
+    if (CHECK_FUNC(c, inv_transform_4x4_2nd)) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        CHECK_RUN(b_ok, time_ref, time_opt,
+                  check_fill_coef(c, b->coef_ref, 4 * 4, 2047);
+                  memcpy(b->coef_opt, b->coef_ref, sizeof(b->coef_ref)),
+                  c->ref->inv_transform_4x4_2nd(b->coef_ref, 4),
+                  c->opt->inv_transform_4x4_2nd(b->coef_opt, 4),
+                  b->coef_ref, b->coef_opt);
+        check_report(c, "inv_transform_4x4_2nd", -1, -1, b_ok, time_ref, time_opt);
+    }
+
+    if (CHECK_FUNC(c, inv_transform_2nd)) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        int size;
+
+        for (size = 8; size <= 32; size <<= 1) {
+            int mode = 0, b_top = 0, b_left = 0;
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_coef(c, b->coef_ref, size * size, 2047);
+                      memcpy(b->coef_opt, b->coef_ref, sizeof(b->coef_ref));
+                      mode = check_rand_range(c, 0, NUM_INTRA_MODE - 1);
+                      b_top = check_rand(c) & 1; b_left = check_rand(c) & 1,
+                      c->ref->inv_transform_2nd(b->coef_ref, size, mode, b_top, b_left),
+                      c->opt->inv_transform_2nd(b->coef_opt, size, mode, b_top, b_left),
+                      b->coef_ref, b->coef_opt);
+        }
+        check_report(c, "inv_transform_2nd", -1, -1, b_ok, time_ref, time_opt);
+    }
+
+    if (CHECK_FUNC(c, dequant)) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        int size;
+
+        for (size = 4; size <= 32; size <<= 1) {
+            int scale = 0, shift = 0;
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_coef(c, b->coef_ref, size * size, 2047);
+                      memcpy(b->coef_opt, b->coef_ref, sizeof(b->coef_ref));
+                      scale = check_rand_range(c, 32768, 65535); shift = check_rand_range(c, 1, 15),
+                      c->ref->dequant(b->coef_ref, size * size, scale, shift),
+                      c->opt->dequant(b->coef_opt, size * size, scale, shift),
+                      b->coef_ref, b->coef_opt);
+        }
+        check_report(c, "dequant", -1, -1, b_ok, time_ref, time_opt);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * deblocking, SAO and ALF
+ */
+static void check_loop_filter(check_t *c)
+{
+    check_buf_t *b = c->buf;
+    const int i_buf = CHECK_STRIDE;
+    const int shift = g_bit_depth - 8;
+    pel_t *src  = b->src  + CHECK_OFFSET;
+    pel_t *ref  = b->ref  + CHECK_OFFSET;
+    pel_t *opt  = b->opt  + CHECK_OFFSET;
+    pel_t *ref2 = b->ref2 + CHECK_OFFSET;
+    pel_t *opt2 = b->opt2 + CHECK_OFFSET;
+    int dir, i;
+
+    for (dir = 0; dir < 2; dir++) {
+        uint8_t flt_flag[2];
+        int alpha = 0, beta = 0;
+
+        if (CHECK_FUNC(c, deblock_luma[dir])) {
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+            for (i = 0; i < CHECK_NUM_RUNS; i++) {
+                CHECK_RUN(b_ok, time_ref, time_opt,
+                          check_fill_pel_smooth(c, b->ref, CHECK_STRIDE * CHECK_STRIDE, 4 << shift);
+                          memcpy(b->opt, b->ref, sizeof(b->ref));
+                          alpha = check_rand_range(c, 0, 63) << shift; beta = check_rand_range(c, 0, 27) << shift;
+                          flt_flag[0] = (uint8_t)(check_rand(c) & 1); flt_flag[1] = (uint8_t)(check_rand(c) & 1),
+                          c->ref->deblock_luma[dir](ref, i_buf, alpha, beta, flt_flag),
+                          c->opt->deblock_luma[dir](opt, i_buf, alpha, beta, flt_flag),
+                          b->ref, b->opt);
+            }
+            check_report(c, "deblock_luma", dir, -1, b_ok, time_ref, time_opt);
+        }
+
+        if (CHECK_FUNC(c, deblock_chroma[dir])) {
+            int64_t time_ref = 0, time_opt = 0;
+            int b_ok = 1;
+#if HDR_CHROMA_DELTA_QP
+            int alpha_c[2], beta_c[2];
+#define CHECK_ALPHA_C   alpha_c
+#define CHECK_BETA_C    beta_c
+#else
+#define CHECK_ALPHA_C   alpha
+#define CHECK_BETA_C    beta
+#endif
+            for (i = 0; i < CHECK_NUM_RUNS; i++) {
+                CHECK_RUN(b_ok, time_ref, time_opt,
+                          check_fill_pel_smooth(c, b->ref,  CHECK_STRIDE * CHECK_STRIDE, 4 << shift);
+                          check_fill_pel_smooth(c, b->ref2, CHECK_STRIDE * CHECK_STRIDE, 4 << shift);
+                          memcpy(b->opt, b->ref, sizeof(b->ref)); memcpy(b->opt2, b->ref2, sizeof(b->ref2));
+                          alpha = check_rand_range(c, 0, 63) << shift; beta = check_rand_range(c, 0, 27) << shift;
+#if HDR_CHROMA_DELTA_QP
+                          alpha_c[0] = alpha_c[1] = alpha; beta_c[0] = beta_c[1] = beta;
+#endif
+                          flt_flag[0] = (uint8_t)(check_rand(c) & 1); flt_flag[1] = (uint8_t)(check_rand(c) & 1),
+                          c->ref->deblock_chroma[dir](ref, ref2, i_buf, CHECK_ALPHA_C, CHECK_BETA_C, flt_flag),
+                          c->opt->deblock_chroma[dir](opt, opt2, i_buf, CHECK_ALPHA_C, CHECK_BETA_C, flt_flag),
+                          b->ref, b->opt);
+                b_ok &= !memcmp(b->ref2, b->opt2, sizeof(b->ref2));
+            }
+#undef CHECK_ALPHA_C
+#undef CHECK_BETA_C
+            check_report(c, "deblock_chroma", dir, -1, b_ok, time_ref, time_opt);
+        }
+    }
+
+    for (i = 0; i < 5; i++) {
+        /* 0-3: EO types, 4: BO */
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        int run;
+
+        if ((i < 4 && !CHECK_FUNC(c, sao_filter_eo[i])) || (i == 4 && !CHECK_FUNC(c, sao_block_bo))) {
+            continue;
+        }
+
+        for (run = 0; run < CHECK_NUM_RUNS; run++) {
+            /* region of one LCU, extended or shrunk by SAO_SHIFT_PIX_NUM, for luma and chroma */
+            int w = check_rand_range(c, 1, (MAX_CU_SIZE + SAO_SHIFT_PIX_NUM) >> 2) << 2;
+            int h = check_rand_range(c, 1, (MAX_CU_SIZE + SAO_SHIFT_PIX_NUM) >> 2) << 2;
+            int avail[8];
+            sao_param_t sao_param;
+            int k;
+
+            if (check_rand(c) & 1) {
+                w >>= 1;
+                h >>= 1;
+            }
+
+            memset(&sao_param, 0, sizeof(sao_param));
+            for (k = 0; k < 4; k++) {
+                avail[k] = check_rand(c) & 1;
+            }
+            avail[4] = avail[0] && avail[2];
+            avail[5] = avail[0] && avail[3];
+            avail[6] = avail[1] && avail[2];
+            avail[7] = avail[1] && avail[3];
+
+            if (i < 4) {
+                for (k = 0; k < 5; k++) {
+                    sao_param.offset[k] = k == 2 ? 0 : check_rand_range(c, -7, 7);
+                }
+                CHECK_RUN(b_ok, time_ref, time_opt,
+                          check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                          c->ref->sao_filter_eo[i](ref, i_buf, src, i_buf, w, h, g_bit_depth, avail, sao_param.offset),
+                          c->opt->sao_filter_eo[i](opt, i_buf, src, i_buf, w, h, g_bit_depth, avail, sao_param.offset),
+                          b->ref, b->opt);
+            } else {
+                sao_param.modeIdc    = SAO_MODE_NEW;
+                sao_param.typeIdc    = SAO_TYPE_BO;
+                sao_param.startBand  = check_rand_range(c, 0, 31);
+                sao_param.startBand2 = (sao_param.startBand + check_rand_range(c, 2, 30)) % 32;
+                sao_param.offset[(sao_param.startBand     )     ] = check_rand_range(c, -7, 7);
+                sao_param.offset[(sao_param.startBand  + 1) % 32] = check_rand_range(c, -7, 7);
+                sao_param.offset[(sao_param.startBand2    )     ] = check_rand_range(c, -7, 7);
+                sao_param.offset[(sao_param.startBand2 + 1) % 32] = check_rand_range(c, -7, 7);
+                CHECK_RUN(b_ok, time_ref, time_opt,
+                          check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c),
+                          c->ref->sao_block_bo(ref, i_buf, src, i_buf, w, h, g_bit_depth, &sao_param),
+                          c->opt->sao_block_bo(opt, i_buf, src, i_buf, w, h, g_bit_depth, &sao_param),
+                          b->ref, b->opt);
+            }
+        }
+        check_report(c, i < 4 ? "sao_filter_eo" : "sao_block_bo", i < 4 ? i : -1, -1, b_ok, time_ref, time_opt);
+    }
+
+    for (i = 0; i < 2; i++) {
+        int64_t time_ref = 0, time_opt = 0;
+        int b_ok = 1;
+        int size;
+
+        if (!CHECK_FUNC(c, alf_block[i])) {
+            continue;
+        }
+
+        /* the LCU is placed at (32, 32) of the buffers, chroma LCUs are smaller */
+        /* the coefficients are reconstructed like alf_recon_coefficients() does, and
+         * kept small enough for the 8-bit coefficients of the SIMD version */
+        for (size = MAX_CU_SIZE >> 2; size <= MAX_CU_SIZE; size <<= 1) {
+            int coeff[ALF_MAX_NUM_COEF];
+            int b_top = 0, b_down = 0, sum = 0, k;
+
+            CHECK_RUN(b_ok, time_ref, time_opt,
+                      check_fill_pel(c, b->src, CHECK_STRIDE * CHECK_STRIDE); check_reset_dst(c);
+                      for (k = 0, sum = 0; k < ALF_MAX_NUM_COEF - 1; k++) { coeff[k] = check_rand_range(c, -3, 3); sum += 2 * coeff[k]; }
+                      coeff[ALF_MAX_NUM_COEF - 1] = (1 << ALF_NUM_BIT_SHIFT) - sum + check_rand_range(c, -8, 8);
+                      b_top = check_rand(c) & 1; b_down = check_rand(c) & 1,
+                      c->ref->alf_block[i](b->ref, b->src, i_buf, 32, 32, size, size, coeff, b_top, b_down),
+                      c->opt->alf_block[i](b->opt, b->src, i_buf, 32, 32, size, size, coeff, b_top, b_down),
+                      b->ref, b->opt);
+        }
+        check_report(c, "alf_block", i, -1, b_ok, time_ref, time_opt);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * the same as cu_get_mc_pos() in cu.cc
+ */
+static int check_mc_pos(int img_size, int blk_size, int blk_pos, int mv)
+{
+    int imv = mv >> 2;
+    int fmv = mv & 7;
+
+    if (blk_pos + imv < -blk_size - 8) {
+        return ((-blk_size - 8) << 2) + (fmv);
+    } else if (blk_pos + imv > img_size + 4) {
+        return ((img_size + 4) << 2) + (fmv);
+    } else {
+        return (blk_pos << 2) + mv;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * copy a w x h plane into dst and replicate its edges over pad pixels, the
+ * way reference pictures were padded before the edge emulation
+ */
+static void check_pad_plane(pel_t *dst, int i_dst, int pad, const pel_t *src, int i_src, int w, int h)
+{
+    int x, y;
+
+    for (y = -pad; y < h + pad; y++) {
+        for (x = -pad; x < w + pad; x++) {
+            dst[y * i_dst + x] = src[DAVS2_CLIP3(0, h - 1, y) * i_src + DAVS2_CLIP3(0, w - 1, x)];
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * motion compensation with MVs pointing outside of the picture: mc_luma() and
+ * mc_chroma() on an unpadded reference picture, which emulate the edges, are
+ * compared against the same calls on a copy of the picture padded by
+ * CHECK_MC_PAD pixels, which read the reference block directly. the margin of
+ * the unpadded picture holds random samples, so that any use of samples
+ * outside of the picture shows as a mismatch
+ */
+#define CHECK_MC_PAD        80    /* luma padding of reference pictures before the edge emulation */
+#define CHECK_MC_WIDTH      96    /* size of the luma plane of the reference picture */
+#define CHECK_MC_HEIGHT     72
+
+static void check_mc_edge(check_t *c)
+{
+    const int w_pic  = CHECK_MC_WIDTH;
+    const int h_pic  = CHECK_MC_HEIGHT;
+    const int i_org  = w_pic + 2 * AVS2_PAD;
+    const int i_pad  = w_pic + 2 * CHECK_MC_PAD;
+    const int n_org  = i_org * (h_pic + 2 * AVS2_PAD);
+    const int n_pad  = i_pad * (h_pic + 2 * CHECK_MC_PAD);
+    /* offset of the picture in the padded planes, in 1/4 luma and 1/8 chroma pixels */
+    const int offset = CHECK_MC_PAD << 2;
+    check_buf_t *b = c->buf;
+    davs2_t *h = NULL;
+    pel_t *buf_org = NULL;
+    pel_t *buf_pad = NULL;
+    pel_t *org_y, *org_c, *pad_y, *pad_c;
+    int64_t luma_ref = 0, luma_opt = 0, chroma_ref = 0, chroma_opt = 0;
+    int b_luma_ok = 1, b_chroma_ok = 1;
+    int part;
+
+    /* luma plane, chroma plane and room for SIMD over-reads */
+    h       = (davs2_t *)davs2_malloc(sizeof(davs2_t));
+    buf_org = (pel_t *)davs2_malloc((n_org + (n_org >> 2) + 2 * MAX_CU_SIZE) * sizeof(pel_t));
+    buf_pad = (pel_t *)davs2_malloc((n_pad + (n_pad >> 2) + 2 * MAX_CU_SIZE) * sizeof(pel_t));
+    if (h == NULL || buf_org == NULL || buf_pad == NULL) {
+        printf("check mc edge: failed to allocate memory\n");
+        c->num_failed++;
+        goto fail;
+    }
+
+    memset(h, 0, sizeof(davs2_t));
+    h->i_chroma_format = CHROMA_420;
+
+    org_y = buf_org + AVS2_PAD * i_org + AVS2_PAD;
+    org_c = buf_org + n_org + (AVS2_PAD >> 1) * (i_org >> 1) + (AVS2_PAD >> 1);
+    pad_y = buf_pad;
+    pad_c = buf_pad + n_pad;
+
+    check_fill_pel(c, buf_org, n_org + (n_org >> 2) + 2 * MAX_CU_SIZE);
+    check_pad_plane(pad_y + CHECK_MC_PAD * i_pad + CHECK_MC_PAD, i_pad, CHECK_MC_PAD,
+                    org_y, i_org, w_pic, h_pic);
+    check_pad_plane(pad_c + (CHECK_MC_PAD >> 1) * (i_pad >> 1) + (CHECK_MC_PAD >> 1), i_pad >> 1, CHECK_MC_PAD >> 1,
+                    org_c, i_org >> 1, w_pic >> 1, h_pic >> 1);
+
+    /* 4x4 is not a prediction block size of inter CUs */
+    for (part = 1; part < MAX_PART_NUM; part++) {
+        const int w = CHECK_PART_SIZE[part][0];
+        const int k = CHECK_PART_SIZE[part][1];
+        int pos_x = 0, pos_y = 0;
+
+        if (w > w_pic || k > h_pic) {
+            continue;
+        }
+
+        /* the block lies anywhere in the picture, its MV reaches up to twice
+         * the picture size away and is clipped as in the decoder */
+#define CHECK_MC_EDGE_SETUP \
+        pos_x = check_mc_pos(w_pic, w, check_rand_range(c, 0, (w_pic - w) >> 2) << 2, check_rand_range(c, -8 * w_pic, 8 * w_pic));\
+        pos_y = check_mc_pos(h_pic, k, check_rand_range(c, 0, (h_pic - k) >> 2) << 2, check_rand_range(c, -8 * h_pic, 8 * h_pic));\
+        check_reset_dst(c)
+
+        CHECK_RUN(b_luma_ok, luma_ref, luma_opt,
+                  CHECK_MC_EDGE_SETUP,
+                  (h->i_width = w_pic + 2 * CHECK_MC_PAD, h->i_height = h_pic + 2 * CHECK_MC_PAD,
+                   mc_luma(h, b->ref, CHECK_STRIDE, pos_x + offset, pos_y + offset, w, k, pad_y, i_pad)),
+                  (h->i_width = w_pic, h->i_height = h_pic,
+                   mc_luma(h, b->opt, CHECK_STRIDE, pos_x, pos_y, w, k, org_y, i_org)),
+                  b->ref, b->opt);
+        CHECK_RUN(b_chroma_ok, chroma_ref, chroma_opt,
+                  CHECK_MC_EDGE_SETUP,
+                  (h->i_width = w_pic + 2 * CHECK_MC_PAD, h->i_height = h_pic + 2 * CHECK_MC_PAD,
+                   mc_chroma(h, b->ref, CHECK_STRIDE, pos_x + offset, pos_y + offset, w >> 1, k >> 1, pad_c, i_pad >> 1)),
+                  (h->i_width = w_pic, h->i_height = h_pic,
+                   mc_chroma(h, b->opt, CHECK_STRIDE, pos_x, pos_y, w >> 1, k >> 1, org_c, i_org >> 1)),
+                  b->ref, b->opt);
+#undef CHECK_MC_EDGE_SETUP
+    }
+
+    check_report(c, "mc_luma_edge", -1, -1, b_luma_ok, luma_ref, luma_opt);
+    check_report(c, "mc_chroma_edge", -1, -1, b_chroma_ok, chroma_ref, chroma_opt);
+
+fail:
+    davs2_free(buf_pad);
+    davs2_free(buf_org);
+    davs2_free(h);
+}
+
+/* ---------------------------------------------------------------------------
+ * check all functions of one CPU tier
+ */
+static void check_tier(check_t *c)
+{
+    check_pixel(c);
+    check_mc(c);
+    check_intra(c);
+    check_transform(c);
+    check_loop_filter(c);
+}
+
+/* ---------------------------------------------------------------------------
+ * compare the function handles of all CPU tiers up to cpuid against the C
+ * functions, for each bit depth the build supports. returns the number of
+ * functions failed, -1 on error
+ */
+static int check_all_primitives(uint32_t cpuid, uint32_t seed)
+{
+#if HIGH_BIT_DEPTH
+    static const int BIT_DEPTHS[] = { 8, 10 };
+    const int bit_depth_bak = g_bit_depth;
+#else
+    static const int BIT_DEPTHS[] = { 8 };
+#endif
+    const int num_tiers = sizeof(CHECK_TIERS) / sizeof(CHECK_TIERS[0]);
+    ao_funcs_t *funcs = NULL;
+    check_t c;
+    int ret = -1;
+    int i, k;
+
+    memset(&c, 0, sizeof(c));
+    c.buf = (check_buf_t *)davs2_malloc(sizeof(check_buf_t));
+    funcs = (ao_funcs_t *)davs2_malloc((num_tiers + 1) * sizeof(ao_funcs_t));
+    if (c.buf == NULL || funcs == NULL) {
+        goto fail;
+    }
+
+    /* funcs[0] holds the C functions, funcs[i + 1] the ones of tier i */
+    memset(funcs, 0, (num_tiers + 1) * sizeof(ao_funcs_t));
+    init_primitives(0, &funcs[0]);
+    for (i = 0, k = 0; i < num_tiers; i++) {
+        k |= CHECK_TIERS[i].flags;
+        init_primitives(cpuid & k, &funcs[i + 1]);
+    }
+
+    for (k = 0; k < (int)(sizeof(BIT_DEPTHS) / sizeof(BIT_DEPTHS[0])); k++) {
+#if HIGH_BIT_DEPTH
+        g_bit_depth   = BIT_DEPTHS[k];
+        max_pel_value = (1 << g_bit_depth) - 1;
+        g_dc_value    = 1 << (g_bit_depth - 1);
+#endif
+        printf("check primitives, %d-bit\n", BIT_DEPTHS[k]);
+        for (i = 0; i < num_tiers; i++) {
+            if ((cpuid & CHECK_TIERS[i].flags) == 0) {
+                continue;
+            }
+            c.ref  = &funcs[0];
+            c.prev = &funcs[i];
+            c.opt  = &funcs[i + 1];
+            c.tier = CHECK_TIERS[i].name;
+            c.seed = seed;
+            check_tier(&c);
+        }
+
+        /* edge emulation of the decoder, with the best functions of the CPU */
+        c.tier = "MC";
+        c.seed = seed;
+        check_mc_edge(&c);
+    }
+
+#if HIGH_BIT_DEPTH
+    g_bit_depth   = bit_depth_bak;
+    max_pel_value = (1 << g_bit_depth) - 1;
+    g_dc_value    = 1 << (g_bit_depth - 1);
+#endif
+
+    printf("check primitives: %d checked, %d failed\n", c.num_checked, c.num_failed);
+    ret = c.num_failed;
+
+fail:
+    davs2_free(funcs);
+    davs2_free(c.buf);
+    return ret;
+}
+
+/* ---------------------------------------------------------------------------
+ * usage: checkasm [seed]
+ */
+int main(int argc, char **argv)
+{
+    uint32_t seed  = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 0x20180101;
+    uint32_t cpuid = 0;
+    char buf_cpu[120] = "";
+    int ret;
+
+#if HAVE_MMX
+    cpuid = davs2_cpu_detect();
+#endif
+
+    davs2_get_simd_capabilities(buf_cpu, cpuid);
+    printf("CPU capabilities: %s, seed: 0x%08x\n", buf_cpu, seed);
+
+    /* some functions call other ones through the global handles */
+    init_all_primitives(cpuid);
+
+    ret = check_all_primitives(cpuid, seed);
+
+    return ret != 0;
+}
@@ -46,6 +46,22 @@
 #define ISPIC(x)  ((x) == 0xB3 || (x) == 0xB6)
 #define ISUNIT(x) ((x) == 0xB0 || (x) == 0xB1 || (x) == 0xB7 || ISPIC(x))
 
+#define INPUT_CHUNK_SIZE  (4 << 20)     /* bytes read from the input file at a time */
+
+/* ---------------------------------------------------------------------------
+ * input bitstream read in chunks, so that files of any size and pipes can
+ * be decoded without holding the whole bitstream in memory
+ */
+typedef struct input_stream_t {
+    FILE    *fp;
+    uint8_t *buf;         /* buffered bitstream */
+    int      size;        /* size of the buffer */
+    int      pos;         /* start of the next packet */
+    int      scan;        /* no start code in [pos + 4, scan) */
+    int      end;         /* end of the buffered bitstream */
+    int      b_eof;       /* no more data in the file */
+} input_stream_t;
+
 /* ---------------------------------------------------------------------------
  */
 static __inline 
@@ -119,28 +135,145 @@ count_frames(uint8_t *data, int size)
 
 
 /* ---------------------------------------------------------------------------
-*/
-static int 
-read_input_file(davs2_input_param_t *p_param, uint8_t **data, int *size, int *frames, float errrate)
+ */
+static int
+input_stream_open(input_stream_t *s, FILE *fp)
 {
-    /* get size of input file */
-    fseek(p_param->g_infile, 0, SEEK_END);
-    *size = ftell(p_param->g_infile);
-    fseek(p_param->g_infile, 0, SEEK_SET);
-
-    /* memory for stream buffer */
-    if ((*data = (uint8_t *)calloc(*size + 1024, sizeof(uint8_t))) == NULL) {
-        show_message(CONSOLE_RED, "failed to alloc memory for input file.\n");
+    memset(s, 0, sizeof(input_stream_t));
+    s->fp   = fp;
+    s->size = 2 * INPUT_CHUNK_SIZE;
+    if ((s->buf = (uint8_t *)malloc(s->size)) == NULL) {
+        show_message(CONSOLE_RED, "failed to alloc memory for input stream.\n");
         return -1;
     }
 
-    /* read stream data */
-    if (fread(*data, *size, 1, p_param->g_infile) < 1) {
-        show_message(CONSOLE_RED, "failed to read input file.\n");
-        free(*data);
-        *data = NULL;
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ */
+static void
+input_stream_close(input_stream_t *s)
+{
+    if (s->buf) {
+        free(s->buf);
+        s->buf = NULL;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * restart from the beginning of the file (seekable files only)
+ */
+static __inline int
+input_stream_rewind(input_stream_t *s)
+{
+    s->pos   = 0;
+    s->scan  = 0;
+    s->end   = 0;
+    s->b_eof = 0;
+
+    return fseek(s->fp, 0, SEEK_SET);
+}
+
+/* ---------------------------------------------------------------------------
+ * read the next chunk, the unconsumed bytes are carried over to the front
+ * of the buffer (which grows for a packet larger than a chunk)
+ */
+static int
+input_stream_fill(input_stream_t *s)
+{
+    int remain = s->end - s->pos;
+    size_t n;
+
+    if (s->pos > 0) {
+        memmove(s->buf, s->buf + s->pos, remain);
+        s->scan -= s->pos;
+        s->end   = remain;
+        s->pos   = 0;
+    }
+
+    if (s->size - s->end < INPUT_CHUNK_SIZE) {
+        uint8_t *buf = (uint8_t *)realloc(s->buf, s->end + INPUT_CHUNK_SIZE);
+
+        if (buf == NULL) {
+            show_message(CONSOLE_RED, "failed to alloc memory for input stream.\n");
+            return -1;
+        }
+        s->buf  = buf;
+        s->size = s->end + INPUT_CHUNK_SIZE;
+    }
+
+    n = fread(s->buf + s->end, 1, INPUT_CHUNK_SIZE, s->fp);
+    s->end += (int)n;
+    if (n < INPUT_CHUNK_SIZE) {
+        if (ferror(s->fp)) {
+            show_message(CONSOLE_RED, "failed to read input file.\n");
+        }
+        s->b_eof = 1;
+    }
+
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * get the next packet (from a start code to the next one, or to the end of
+ * the file), the packet is valid until the next call.
+ * returns 1 if a packet is got, 0 at the end of the file, -1 on errors
+ */
+static int
+input_stream_next_packet(input_stream_t *s, const uint8_t **data, int *len)
+{
+    for (;;) {
+        int start = s->scan > s->pos + 4 ? s->scan : s->pos + 4;
+        const uint8_t *p = start < s->end ? find_start_code(s->buf + start, s->end - start) : 0;
+
+        if (p != 0) {
+            *data   = s->buf + s->pos;
+            *len    = (int)(p - *data);
+            s->pos += *len;
+            s->scan = s->pos + 4;
+            return 1;
+        }
+
+        /* the last 3 bytes may be the beginning of a start code */
+        s->scan = s->end - 3 > s->pos + 4 ? s->end - 3 : s->pos + 4;
+
+        if (s->b_eof) {
+            if (s->end > s->pos) {
+                *data  = s->buf + s->pos;
+                *len   = s->end - s->pos;
+                s->pos = s->end;
+                return 1;
+            }
+            return 0;
+        }
+
+        if (input_stream_fill(s) < 0) {
+            return -1;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * read the whole bitstream into memory
+ */
+static int 
+read_input_file(davs2_input_param_t *p_param, uint8_t **data, int *size, int *frames, float errrate)
+{
+    input_stream_t s;
+
+    /* read stream data chunk by chunk (the size of pipes is not known) */
+    if (input_stream_open(&s, p_param->g_infile) < 0) {
         return -1;
     }
+    while (!s.b_eof) {
+        if (input_stream_fill(&s) < 0) {
+            input_stream_close(&s);
+            return -1;
+        }
+    }
+    *data = s.buf;
+    *size = s.end;
 
     if (errrate != 0) {
         show_message(CONSOLE_WHITE, "noise interfering is enabled:\n");
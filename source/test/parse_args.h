@@ -47,11 +47,18 @@ typedef struct davs2_input_param_t {
     const char *s_outfile;
     const char *s_recfile;
     const char *s_md5;
+    const char *s_bench;
 
     int g_verbose;
     int g_psnr;
     int g_threads;
     int b_y4m;     // Y4M or YUV
+    int g_segments;
+    int g_cpu;     // 0: auto, 1: no AVX, 2: C only
+    int g_skip;    // pictures not decoded (davs2_skip_frame_e)
+    int g_fast;    // skip the loop filters of non-reference pictures
+    int g_scale;   // output size, 0: full, 1: 1/2, 2: 1/4
+    int g_conceal; // conceal corrupted LCUs instead of leaving them undecoded
 
     FILE *g_infile;
     FILE *g_recfile;
@@ -63,7 +70,7 @@ typedef struct davs2_input_param_t {
 #endif
 
 /* 包含附加参数的，在字母后面需要加上冒号 */
-static const char *optString = "i:o:r:m:t:vh?";
+static const char *optString = "i:o:r:m:t:s:c:b:k:fd:evh?";
 
 static const struct option longOpts[] = {
     {"input",   required_argument, NULL, 'i'},
@@ -71,6 +78,13 @@ static const struct option longOpts[] = {
     {"psnr",    required_argument, NULL, 'r'},
     {"md5",     required_argument, NULL, 'm'},
     {"threads", required_argument, NULL, 't'},
+    {"segments",required_argument, NULL, 's'},
+    {"cpu",     required_argument, NULL, 'c'},
+    {"bench",   required_argument, NULL, 'b'},
+    {"skip",    required_argument, NULL, 'k'},
+    {"fast",    no_argument, NULL, 'f'},
+    {"downscale", required_argument, NULL, 'd'},
+    {"conceal", no_argument, NULL, 'e'},
     {"verbose", no_argument, NULL, 'v'},
     {"help",    no_argument, NULL, 'h'},
     {NULL, no_argument, NULL, 0}
@@ -82,17 +96,24 @@ static const struct option longOpts[] = {
 static void display_usage(void)
 {
     /* 运行参数说明 */
-    const char * usage = "usage: davs2 -i avs2file -o outputfile [-r recfile] [-t threads] [-v]";
+    const char * usage = "usage: davs2 -i avs2file -o outputfile [-r recfile] [-t threads] [-s segments] [-c cpu] [-b bench.json] [-k skip] [-f] [-d scale] [-e] [-v]";
 
     show_message(CONSOLE_RED, "davs2 parameters\n    %s\n", usage);
     show_message(CONSOLE_RED, "+------------------+-------------+-------------------------------------------+\n");
     show_message(CONSOLE_RED, "|     Parameter    |    Alias    |                  Settings                 |\n");
     show_message(CONSOLE_RED, "+------------------+-------------+-------------------------------------------+\n");
-    show_message(CONSOLE_RED, "| --input=test.avs | -i test.avs | input bitstream file path                 |\n");
+    show_message(CONSOLE_RED, "| --input=test.avs | -i test.avs | input bitstream file path (or stdin)      |\n");
     show_message(CONSOLE_RED, "| --output=dec.yuv | -o dec.yuv  | output YUV/Y4M file path                  |\n");
     show_message(CONSOLE_RED, "| --psnr=rec.yuv   | -r rec.yuv  | reference reconstruction YUV file         |\n");
     show_message(CONSOLE_RED, "| --threads=N      | -t N        | threads for decoding (default: 1)         |\n");
+    show_message(CONSOLE_RED, "| --segments=N     | -s N        | decode N closed-GOP segments in parallel  |\n");
     show_message(CONSOLE_RED, "| --md5=M          | -m M        | Reference MD5 of decoded YUV              |\n");
+    show_message(CONSOLE_RED, "| --cpu=N          | -c N        | SIMD: 0 auto, 1 without AVX, 2 C only     |\n");
+    show_message(CONSOLE_RED, "| --bench=b.json   | -b b.json   | append fps/latency/CPU/memory as JSON     |\n");
+    show_message(CONSOLE_RED, "| --skip=N         | -k N        | skip: 1 non-ref, 2 non-intra, 3 non-I     |\n");
+    show_message(CONSOLE_RED, "| --fast           | -f          | no loop filters for non-ref pictures      |\n");
+    show_message(CONSOLE_RED, "| --downscale=N    | -d N        | output size: 0 full, 1 half, 2 quarter    |\n");
+    show_message(CONSOLE_RED, "| --conceal        | -e          | conceal corrupted parts of the pictures   |\n");
     show_message(CONSOLE_RED, "| --verbose        | -v          | Enable decoding status every frame        |\n");
     show_message(CONSOLE_RED, "| --help           | -h          | Showing this instruction                  |\n");
     show_message(CONSOLE_RED, "+------------------+-------------+-------------------------------------------+\n");
@@ -122,6 +143,7 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
     p_param->s_outfile = NULL;
     p_param->s_recfile = NULL;
     p_param->s_md5     = NULL;
+    p_param->s_bench   = NULL;
     p_param->g_infile  = NULL;
     p_param->g_outfile = NULL;
     p_param->g_recfile = NULL;
@@ -129,6 +151,12 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
     p_param->g_psnr    = 0;
     p_param->g_threads = 1;
     p_param->b_y4m     = 0;
+    p_param->g_segments = 1;
+    p_param->g_cpu     = 0;
+    p_param->g_skip    = 0;
+    p_param->g_fast    = 0;
+    p_param->g_scale   = 0;
+    p_param->g_conceal = 0;
 
     opt = getopt_long(argc, argv, optString, longOpts, &longIndex);
     while (opt != -1) {
@@ -151,6 +179,28 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
         case 't':
             p_param->g_threads = atoi(optarg);
             break;
+        case 's':
+            p_param->g_segments = atoi(optarg);
+            break;
+        case 'c':
+            p_param->g_cpu = atoi(optarg);
+            break;
+        case 'b':
+            p_param->s_bench = optarg;
+            break;
+        case 'k':
+            p_param->g_skip = atoi(optarg);
+            break;
+        case 'f':
+            p_param->g_fast = 1;
+            break;
+        case 'd':
+            p_param->g_scale = atoi(optarg);
+            p_param->g_scale = p_param->g_scale < 0 ? 0 : (p_param->g_scale > 2 ? 2 : p_param->g_scale);
+            break;
+        case 'e':
+            p_param->g_conceal = 1;
+            break;
         case 'h':   /* fall-through is intentional */
         case '?':
             display_usage();
@@ -171,7 +221,14 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
         return -1;
     }
 
-    p_param->g_infile  = fopen(p_param->s_infile, "rb");
+    if (!strcmp(p_param->s_infile, "stdin") || !strcmp(p_param->s_infile, "-")) {
+        p_param->g_infile = stdin;
+#if _WIN32
+        setmode(fileno(stdin), O_BINARY);
+#endif
+    } else {
+        p_param->g_infile = fopen(p_param->s_infile, "rb");
+    }
 
     if (p_param->s_recfile != NULL) {
         p_param->g_recfile = fopen(p_param->s_recfile, "rb");
@@ -183,6 +240,9 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
         } else {
             p_param->g_outfile = fopen(p_param->s_outfile, "wb");
         }
+        if (p_param->g_outfile != NULL) {
+            setvbuf(p_param->g_outfile, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+        }
     } else if (p_param->g_outfile == NULL) {
         display_usage();
         show_message(CONSOLE_RED, "WARN: missing output file.\n");
@@ -199,6 +259,16 @@ static int parse_args(davs2_input_param_t *p_param, int argc, char **argv)
         show_message(CONSOLE_RED, "ERROR: failed to open reference file: %s\n", p_param->s_recfile);
     }
     p_param->g_psnr = (p_param->g_recfile != NULL);
+    if (p_param->g_psnr && p_param->g_segments > 1) {
+        /* POCs restart in each segment */
+        show_message(CONSOLE_RED, "WARN: PSNR is not supported with segments, decoding as one segment.\n");
+        p_param->g_segments = 1;
+    }
+    if (p_param->g_psnr && p_param->g_scale > 0) {
+        /* the reference reconstruction has the full size */
+        show_message(CONSOLE_RED, "WARN: PSNR is not supported with downscaled output, disabled.\n");
+        p_param->g_psnr = 0;
+    }
 
     /* open output file */
     if (p_param->s_outfile != NULL && p_param->g_outfile == NULL) {
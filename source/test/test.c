@@ -46,6 +46,8 @@
 #include "psnr.h"
 #include "parse_args.h"
 #include "inputstream.h"
+#include "writer.h"
+#include "bench.h"
 #include "md5.h"
 
 #if defined(_MSC_VER)
@@ -61,6 +63,7 @@ extern "C" {
  * macro defines
  * ===========================================================================
  */
+#define MAX_SPLIT_POINTS   4096   /* max number of split points of the bitstream for segments */
 #define CTRL_LOOP_DEC_FILE    0   /* ѭһESļ */
 
 /* ---------------------------------------------------------------------------
@@ -84,6 +87,7 @@ int g_frmcount = 0;
 int g_psnrfail = 0;
 unsigned int   MD5val[4];
 char           MD5str[33];
+bench_t        g_bench;         /* statistics for --bench */
 
 davs2_input_param_t inputparam = {
     NULL, NULL, NULL, NULL, 0, 0, 0, 0
@@ -130,7 +134,7 @@ void output_decoded_frame(davs2_picture_t *pic, davs2_seq_info_t *headerset, int
             };
             int fps_num = FRAME_RATE[headerset->frame_rate_id][0];
             int fps_den = FRAME_RATE[headerset->frame_rate_id][1];
-            write_y4m_header(inputparam.g_outfile, headerset->width, headerset->height,
+            write_y4m_header(inputparam.g_outfile, headerset->width >> inputparam.g_scale, headerset->height >> inputparam.g_scale,
                              fps_num, fps_den, headerset->output_bit_depth);
         }
         return;
@@ -172,62 +176,55 @@ void output_decoded_frame(davs2_picture_t *pic, davs2_seq_info_t *headerset, int
 }
 
 /* ---------------------------------------------------------------------------
- * data_buf - pointer to bitstream buffer
- * data_len - number of bytes in bitstream buffer
- * frames   - number of frames in bitstream buffer
+ * decode the bitstream packet by packet as it is read from the input
  */
-void test_decoder(uint8_t *data_buf, int data_len, int num_frames, char *dst)
+static
+void decode_stream(davs2_param_t *param, FILE *fp_in, int num_frames)
 {
-    const double f_time_fac = 1.0 / (double)CLOCKS_PER_SEC;
-    davs2_param_t    param;      // decoding parameters
     davs2_packet_t   packet;     // input bitstream
     davs2_picture_t  out_frame;  // output data, frame data
     davs2_seq_info_t headerset;  // output data, sequence header
+    input_stream_t   stream;
+    output_writer_t  writer;     // writes the decoded frames in another thread
+    int b_async;
     int got_frame;
 
 #if CTRL_LOOP_DEC_FILE
-    uint8_t *bak_data_buf = data_buf;
-    int      bak_data_len = data_len;
     int      num_loop     = 5;      // ѭ
 #endif
-    int64_t time0, time1;
     void *decoder;
 
-    const uint8_t *data = data_buf;
-    const uint8_t *data_next_start_code;
     int user_dts = 0; // only used to check the returning value of DTS and PTS
 
-    /* init the decoder */
-    memset(&param, 0, sizeof(param));
-    param.threads      = inputparam.g_threads;
-    param.opaque       = (void *)(intptr_t)num_frames;
-    param.info_level   = DAVS2_LOG_DEBUG;
-    param.disable_avx  = 0; // on some platforms, disable AVX (setting to 1) would be faster
-
-    decoder = davs2_decoder_open(&param);
+    if (input_stream_open(&stream, fp_in) < 0) {
+        return;
+    }
 
-    time0 = get_time();
+    decoder = davs2_decoder_open(param);
+    b_async = writer_open(&writer, decoder, output_decoded_frame, num_frames) == 0;
 
     /* do decoding */
     for (;;) {
-        int len;
-
-        data_next_start_code = find_start_code(data + 4, data_len - 4);
+        int ret = input_stream_next_packet(&stream, &packet.data, &packet.len);
 
-        if (data_next_start_code) {
-            len = (int)(data_next_start_code - data);
-        } else {
-            len = data_len;
+        if (ret == 0) {
+#if CTRL_LOOP_DEC_FILE
+            num_loop--;
+            if (num_loop > 0 && input_stream_rewind(&stream) == 0) {
+                continue;
+            }
+#endif
+            break;              /* end of bitstream */
+        } else if (ret < 0) {
+            break;
         }
 
-        packet.data = data;
-        packet.len  = len;
-
         // set PTS/DTS, which was only used to check whether they could be passed out rightly
         packet.pts  =  user_dts;
         packet.dts  = -user_dts;
         user_dts++;
 
+        bench_packet_sent(&g_bench, packet.pts);
         got_frame = davs2_decoder_send_packet(decoder, &packet);
         if (got_frame == DAVS2_ERROR) {
             show_message(CONSOLE_RED, "Error: An decoder error counted\n");
@@ -235,25 +232,16 @@ void test_decoder(uint8_t *data_buf, int data_len, int num_frames, char *dst)
         }
 
         got_frame = davs2_decoder_recv_frame(decoder, &headerset, &out_frame);
-        if (got_frame != DAVS2_DEFAULT) {
-            output_decoded_frame(&out_frame, &headerset, got_frame, num_frames);
-            davs2_decoder_frame_unref(decoder, &out_frame);
+        if (got_frame == DAVS2_GOT_FRAME) {
+            bench_frame_out(&g_bench, &out_frame);
         }
-
-        data_len -= len;
-        data += len; // could not be [data = data_next_start_code]
-
-        if (!data_len) {
-#if CTRL_LOOP_DEC_FILE
-            data_len = bak_data_len;
-            data = data_buf;
-            num_loop--;
-            if (num_loop <= 0) {
-                break;
+        if (got_frame != DAVS2_DEFAULT) {
+            if (b_async) {
+                writer_put(&writer, &out_frame, &headerset, got_frame);
+            } else {
+                output_decoded_frame(&out_frame, &headerset, got_frame, num_frames);
+                davs2_decoder_frame_unref(decoder, &out_frame);
             }
-#else
-            break;              /* end of bitstream */
-#endif
         }
     }
 
@@ -263,16 +251,258 @@ void test_decoder(uint8_t *data_buf, int data_len, int num_frames, char *dst)
         if (got_frame == DAVS2_ERROR || got_frame == DAVS2_END) {
             break;
         }
+        if (got_frame == DAVS2_GOT_FRAME) {
+            bench_frame_out(&g_bench, &out_frame);
+        }
         if (got_frame != DAVS2_DEFAULT) {
-            output_decoded_frame(&out_frame, &headerset, got_frame, num_frames);
-            davs2_decoder_frame_unref(decoder, &out_frame);
+            if (b_async) {
+                writer_put(&writer, &out_frame, &headerset, got_frame);
+            } else {
+                output_decoded_frame(&out_frame, &headerset, got_frame, num_frames);
+                davs2_decoder_frame_unref(decoder, &out_frame);
+            }
         }
     }
 
-    time1 = get_time();
-
-    /* close the decoder */
+    /* wait until all frames are written out, then close the decoder */
+    if (b_async) {
+        writer_close(&writer);
+    }
     davs2_decoder_close(decoder);
+    input_stream_close(&stream);
+}
+
+/* ---------------------------------------------------------------------------
+ * segment of the bitstream decoded by its own decoder
+ */
+typedef struct segment_t {
+    void          *decoder;
+    const uint8_t *data;        /* remaining bitstream */
+    int            len;         /* bytes of the remaining bitstream */
+    int            user_dts;
+    int            b_end;       /* all frames are output */
+    int            num_frames;  /* frames output (written to fp_out) */
+    int            b_direct;    /* output directly (the first segment) */
+    FILE          *fp_out;      /* output of the other segments */
+} segment_t;
+
+/* ---------------------------------------------------------------------------
+ */
+static
+void output_segment_frame(segment_t *seg, davs2_picture_t *pic, davs2_seq_info_t *headerset, int ret_type, int num_frames)
+{
+    if (seg->b_direct) {
+        output_decoded_frame(pic, headerset, ret_type, num_frames);
+    } else if (ret_type != DAVS2_GOT_HEADER) {
+        if (seg->fp_out != NULL) {
+            write_frame(pic, seg->fp_out, inputparam.b_y4m);
+        }
+        seg->num_frames++;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * send one packet to the decoder of a segment (or flush it at the end of the
+ * segment) and output a frame if any. returns 0 if the segment is done
+ */
+static
+int decode_segment_step(segment_t *seg, int num_frames)
+{
+    davs2_packet_t   packet;
+    davs2_picture_t  out_frame;
+    davs2_seq_info_t headerset;
+    int got_frame;
+
+    if (seg->b_end) {
+        return 0;
+    }
+
+    if (seg->len > 0) {
+        const uint8_t *data_next_start_code = find_start_code(seg->data + 4, seg->len - 4);
+        int len = data_next_start_code ? (int)(data_next_start_code - seg->data) : seg->len;
+
+        packet.data = seg->data;
+        packet.len  = len;
+        packet.pts  =  seg->user_dts;
+        packet.dts  = -seg->user_dts;
+        seg->user_dts++;
+        seg->data  += len;
+        seg->len   -= len;
+
+        got_frame = davs2_decoder_send_packet(seg->decoder, &packet);
+        if (got_frame == DAVS2_ERROR) {
+            show_message(CONSOLE_RED, "Error: An decoder error counted\n");
+            seg->len = 0;
+            return 1;
+        }
+
+        got_frame = davs2_decoder_recv_frame(seg->decoder, &headerset, &out_frame);
+    } else {
+        got_frame = davs2_decoder_flush(seg->decoder, &headerset, &out_frame);
+        if (got_frame == DAVS2_ERROR || got_frame == DAVS2_END) {
+            seg->b_end = 1;
+            return 0;
+        }
+    }
+
+    if (got_frame != DAVS2_DEFAULT) {
+        output_segment_frame(seg, &out_frame, &headerset, got_frame, num_frames);
+        davs2_decoder_frame_unref(seg->decoder, &out_frame);
+    }
+
+    return 1;
+}
+
+/* ---------------------------------------------------------------------------
+ * split the bitstream into segments at closed GOPs and decode them on
+ * independent decoders in parallel. the decoders are fed in turn and share the
+ * threads of one decoder group, the outputs of the segments except the first
+ * one are kept in temporary files and appended to the output in order
+ */
+static
+void decode_segments(davs2_param_t *param, uint8_t *data_buf, int data_len, int num_frames, int num_segments)
+{
+    static int points[MAX_SPLIT_POINTS];
+    davs2_param_t seg_param = *param;
+    segment_t *segs;
+    void *group;
+    int num_points;
+    int num_active;
+    int start = 0;
+    int i, k;
+
+    num_points = davs2_find_split_points(data_buf, data_len, points, MAX_SPLIT_POINTS);
+
+    segs  = (segment_t *)calloc(num_segments, sizeof(segment_t));
+    group = davs2_group_open(param->threads);
+    if (segs == NULL || group == NULL) {
+        show_message(CONSOLE_RED, "Error: failed to open the decoder group\n");
+        goto fail;
+    }
+
+    /* all the segments are decoded in the threads of the group,
+     * each one with the default number of parallel frames */
+    seg_param.group   = group;
+    seg_param.threads = 0;
+
+    /* split at the points next to the even positions */
+    for (i = 0, k = 0; i < num_segments && start < data_len; i++) {
+        int end = data_len;
+
+        if (i < num_segments - 1) {
+            int64_t target = (int64_t)data_len * (i + 1) / num_segments;
+
+            while (k < num_points && (points[k] < target || points[k] <= start)) {
+                k++;
+            }
+            if (k < num_points) {
+                end = points[k++];
+            }
+        }
+
+        segs[i].data    = data_buf + start;
+        segs[i].len     = end - start;
+        segs[i].decoder = davs2_decoder_open(&seg_param);
+        segs[i].b_direct = i == 0;
+        if (segs[i].decoder == NULL) {
+            show_message(CONSOLE_RED, "Error: failed to open the decoder of segment %d\n", i);
+            num_segments = i;
+            goto fail;
+        }
+        if (i > 0 && inputparam.g_outfile != NULL) {
+            segs[i].fp_out = tmpfile();
+            if (segs[i].fp_out == NULL) {
+                show_message(CONSOLE_RED, "Error: failed to create the temporary output of segment %d\n", i);
+                num_segments = i + 1;
+                goto fail;
+            }
+        }
+        start = end;
+    }
+    num_segments = i;
+
+    show_message(CONSOLE_WHITE, " Segments        : %d (%d split points found)\n", num_segments, num_points);
+
+    /* decode */
+    do {
+        num_active = 0;
+        for (i = 0; i < num_segments; i++) {
+            num_active += decode_segment_step(&segs[i], num_frames);
+        }
+    } while (num_active > 0);
+
+    /* merge the outputs in order */
+    for (i = 0; i < num_segments; i++) {
+        davs2_decoder_close(segs[i].decoder);
+
+        if (segs[i].fp_out != NULL) {
+            char buf[1 << 16];
+            size_t size;
+
+            rewind(segs[i].fp_out);
+            while ((size = fread(buf, 1, sizeof(buf), segs[i].fp_out)) > 0) {
+                fwrite(buf, 1, size, inputparam.g_outfile);
+            }
+            fclose(segs[i].fp_out);
+        }
+
+        g_frmcount += segs[i].num_frames;
+    }
+
+    free(segs);
+    davs2_group_close(group);
+    return;
+
+fail:
+    if (segs != NULL) {
+        for (i = 0; i < num_segments; i++) {
+            if (segs[i].decoder != NULL) {
+                davs2_decoder_close(segs[i].decoder);
+            }
+            if (segs[i].fp_out != NULL) {
+                fclose(segs[i].fp_out);
+            }
+        }
+        free(segs);
+    }
+    if (group != NULL) {
+        davs2_group_close(group);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * data_buf - pointer to bitstream buffer
+ * data_len - number of bytes in bitstream buffer
+ * frames   - number of frames in bitstream buffer
+ */
+void test_decoder(uint8_t *data_buf, int data_len, int num_frames, char *dst)
+{
+    const double f_time_fac = 1.0 / (double)CLOCKS_PER_SEC;
+    davs2_param_t    param;      // decoding parameters
+    int64_t time0, time1;
+
+    /* init the decoder */
+    memset(&param, 0, sizeof(param));
+    param.threads      = inputparam.g_threads;
+    param.opaque       = (void *)(intptr_t)num_frames;
+    param.info_level   = DAVS2_LOG_DEBUG;
+    param.disable_avx  = inputparam.g_cpu; // on some platforms, disable AVX (setting to 1) would be faster
+    param.skip_frame   = inputparam.g_skip;
+    param.fast_preview = inputparam.g_fast;
+    param.output_scale = inputparam.g_scale;
+    param.error_concealment = inputparam.g_conceal;
+
+    /* per-frame latencies are only measured when decoding as one segment */
+    bench_open(&g_bench, inputparam.s_bench != NULL && inputparam.g_segments <= 1);
+    time0 = get_time();
+
+    if (inputparam.g_segments > 1) {
+        decode_segments(&param, data_buf, data_len, num_frames, inputparam.g_segments);
+    } else {
+        decode_stream(&param, inputparam.g_infile, num_frames);
+    }
+
+    time1 = get_time();
 
     /* statistics */
     show_message(CONSOLE_WHITE, "\n--------------------------------------------------\n");
@@ -297,6 +527,14 @@ void test_decoder(uint8_t *data_buf, int data_len, int num_frames, char *dst)
     show_message(CONSOLE_GREEN, "total decoding time: %.3lfs, %6.2lf fps\n", 
         (double)((time1 - time0) * f_time_fac), 
         (double)(g_frmcount / ((time1 - time0) * f_time_fac)));
+
+    if (inputparam.s_bench != NULL) {
+        if (bench_report(&g_bench, inputparam.s_bench, inputparam.s_infile, inputparam.g_threads,
+                         inputparam.g_cpu, inputparam.g_segments, g_frmcount) < 0) {
+            show_message(CONSOLE_RED, "ERROR: failed to write benchmark report: %s\n", inputparam.s_bench);
+        }
+    }
+    bench_close(&g_bench);
 }
 
 /* ---------------------------------------------------------------------------
@@ -306,8 +544,8 @@ int main(int argc, char *argv[])
     char dst[1024] = "> no decode data\n";
     uint8_t *data = NULL;
     clock_t tm_start = clock();
-    int size;
-    int frames;
+    int size   = 0;
+    int frames = 0;     /* unknown unless the whole bitstream is read */
 
 
     memset(MD5val, 0, 16);
@@ -319,8 +557,9 @@ int main(int argc, char *argv[])
         goto fail;
     }
 
-    /* read input data */
-    if (read_input_file(&inputparam, &data, &size, &frames, 0.0f) < 0) {
+    /* read input data, only needed to split the bitstream into segments
+     * (otherwise the bitstream is read while decoding) */
+    if (inputparam.g_segments > 1 && read_input_file(&inputparam, &data, &size, &frames, 0.0f) < 0) {
         sprintf(dst, "Failed to read input bit-stream or create output file\n");
         goto fail;
     }
@@ -44,6 +44,8 @@
 #define CONSOLE_RED    2
 #define CONSOLE_GREEN  3
 
+#define OUTPUT_BUFFER_SIZE  (8 << 20)   /* stdio buffer of the output file, so that rows are written in large blocks */
+
 #if __ANDROID__
 #include <jni.h>
 #include <android/log.h>
@@ -138,6 +140,12 @@ static __inline void show_progress(int frame, int frames)
 
     last_time = cur_time;
 
+    if (frames <= 0) {
+        /* total number of frames is unknown (streaming input) */
+        show_message(CONSOLE_WHITE, "\r frames: %4d,  fps: %4.1f\r", frame, fps);
+        return;
+    }
+
     eta = (int)((frames - frame) * total_time / frame) / (CLOCKS_PER_SEC / 1000);
 
     show_message(CONSOLE_WHITE, "\r frames: %4d/%4d,  fps: %4.1f, LeftTime: %8.3f sec\r",
@@ -152,6 +160,12 @@ void write_frame_plane(FILE *fp_out, const uint8_t *p_src, int img_w, int img_h,
     const int size_line = img_w * bytes_per_sample;
     int i;
 
+    if (i_stride == size_line) {
+        /* contiguous plane, write it at once */
+        fwrite(p_src, size_line, img_h, fp_out);
+        return;
+    }
+
     for (i = 0; i < img_h; i++) {
         fwrite(p_src, size_line, 1, fp_out);
         p_src += i_stride;
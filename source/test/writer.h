@@ -0,0 +1,223 @@
+/*
+ * writer.h
+ *
+ * Description of this file:
+ *    Asynchronous output writer of the davs2 test application
+ *
+ * --------------------------------------------------------------------------
+ *
+ *    davs2 - video decoder of AVS2/IEEE1857.4 video coding standard
+ *    Copyright (C) 2018~ VCL, NELVT, Peking University
+ *
+ *    Authors: Falei LUO <falei.luo@gmail.com>
+ *             etc.
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation; either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02111, USA.
+ *
+ *    This program is also available under a commercial proprietary license.
+ *    For more information, contact us at sswang @ pku.edu.cn.
+ */
+
+#ifndef DAVS2_WRITER_H
+#define DAVS2_WRITER_H
+
+#include "utils.h"
+
+#include <string.h>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define WRITER_QUEUE_SIZE  15   /* max number of decoded pictures waiting for output, with the one
+                                   being written within the 16 output frames the decoder lets us hold */
+
+/* ---------------------------------------------------------------------------
+ * thread primitives
+ */
+#if _WIN32
+typedef HANDLE              writer_thread_t;
+typedef CRITICAL_SECTION    writer_mutex_t;
+typedef CONDITION_VARIABLE  writer_cond_t;
+#define writer_mutex_init(m)        InitializeCriticalSection(m)
+#define writer_mutex_destroy(m)     DeleteCriticalSection(m)
+#define writer_mutex_lock(m)        EnterCriticalSection(m)
+#define writer_mutex_unlock(m)      LeaveCriticalSection(m)
+#define writer_cond_init(c)         InitializeConditionVariable(c)
+#define writer_cond_destroy(c)
+#define writer_cond_wait(c, m)      SleepConditionVariableCS(c, m, INFINITE)
+#define writer_cond_signal(c)       WakeConditionVariable(c)
+#else
+typedef pthread_t           writer_thread_t;
+typedef pthread_mutex_t     writer_mutex_t;
+typedef pthread_cond_t      writer_cond_t;
+#define writer_mutex_init(m)        pthread_mutex_init(m, NULL)
+#define writer_mutex_destroy(m)     pthread_mutex_destroy(m)
+#define writer_mutex_lock(m)        pthread_mutex_lock(m)
+#define writer_mutex_unlock(m)      pthread_mutex_unlock(m)
+#define writer_cond_init(c)         pthread_cond_init(c, NULL)
+#define writer_cond_destroy(c)      pthread_cond_destroy(c)
+#define writer_cond_wait(c, m)      pthread_cond_wait(c, m)
+#define writer_cond_signal(c)       pthread_cond_signal(c)
+#endif
+
+/* ---------------------------------------------------------------------------
+ * output one decoded picture (or sequence header)
+ */
+typedef void(*output_frame_t)(davs2_picture_t *pic, davs2_seq_info_t *headerset, int ret_type, int num_frames);
+
+/* ---------------------------------------------------------------------------
+ * one item in the output queue
+ */
+typedef struct output_item_t {
+    davs2_picture_t  pic;
+    davs2_seq_info_t headerset;
+    int              ret_type;
+} output_item_t;
+
+/* ---------------------------------------------------------------------------
+ * output writer: pictures returned by the decoder are queued here, written
+ * (and checked) by the writer thread, and then released to the decoder
+ */
+typedef struct output_writer_t {
+    void            *decoder;       /* decoder handle the pictures belong to */
+    output_frame_t   output;        /* output function, called in the writer thread */
+    int              num_frames;    /* total number of frames, for the progress */
+
+    writer_thread_t  thread;
+    writer_mutex_t   mutex;
+    writer_cond_t    cv_filled;     /* signaled when an item is queued */
+    writer_cond_t    cv_emptied;    /* signaled when an item is taken */
+    int              b_exit;        /* no more items will be queued */
+    int              head;          /* index of the oldest item */
+    int              num_items;     /* number of items in the queue */
+    output_item_t    items[WRITER_QUEUE_SIZE];
+} output_writer_t;
+
+/* ---------------------------------------------------------------------------
+ */
+static void writer_process(output_writer_t *w)
+{
+    output_item_t item;
+
+    for (;;) {
+        writer_mutex_lock(&w->mutex);
+        while (w->num_items == 0 && !w->b_exit) {
+            writer_cond_wait(&w->cv_filled, &w->mutex);
+        }
+        if (w->num_items == 0) {
+            writer_mutex_unlock(&w->mutex);
+            break;              /* drained and closed */
+        }
+        item    = w->items[w->head];
+        w->head = (w->head + 1) % WRITER_QUEUE_SIZE;
+        w->num_items--;
+        writer_cond_signal(&w->cv_emptied);
+        writer_mutex_unlock(&w->mutex);
+
+        w->output(&item.pic, &item.headerset, item.ret_type, w->num_frames);
+        davs2_decoder_frame_unref(w->decoder, &item.pic);
+    }
+}
+
+#if _WIN32
+static DWORD WINAPI writer_thread_proc(LPVOID arg)
+{
+    writer_process((output_writer_t *)arg);
+    return 0;
+}
+#else
+static void *writer_thread_proc(void *arg)
+{
+    writer_process((output_writer_t *)arg);
+    return NULL;
+}
+#endif
+
+/* ---------------------------------------------------------------------------
+ * start the writer thread, return 0 on success
+ */
+static int writer_open(output_writer_t *w, void *decoder, output_frame_t output, int num_frames)
+{
+    memset(w, 0, sizeof(output_writer_t));
+    w->decoder    = decoder;
+    w->output     = output;
+    w->num_frames = num_frames;
+
+    writer_mutex_init(&w->mutex);
+    writer_cond_init(&w->cv_filled);
+    writer_cond_init(&w->cv_emptied);
+
+#if _WIN32
+    w->thread = CreateThread(NULL, 0, writer_thread_proc, w, 0, NULL);
+    if (w->thread == NULL) {
+#else
+    if (pthread_create(&w->thread, NULL, writer_thread_proc, w) != 0) {
+#endif
+        writer_cond_destroy(&w->cv_emptied);
+        writer_cond_destroy(&w->cv_filled);
+        writer_mutex_destroy(&w->mutex);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * queue one picture, blocks while the queue is full. The picture is released
+ * by the writer thread once it has been written
+ */
+static void writer_put(output_writer_t *w, davs2_picture_t *pic, davs2_seq_info_t *headerset, int ret_type)
+{
+    output_item_t *item;
+
+    writer_mutex_lock(&w->mutex);
+    while (w->num_items == WRITER_QUEUE_SIZE) {
+        writer_cond_wait(&w->cv_emptied, &w->mutex);
+    }
+    item = &w->items[(w->head + w->num_items) % WRITER_QUEUE_SIZE];
+    item->pic       = *pic;
+    item->headerset = *headerset;
+    item->ret_type  = ret_type;
+    w->num_items++;
+    writer_cond_signal(&w->cv_filled);
+    writer_mutex_unlock(&w->mutex);
+}
+
+/* ---------------------------------------------------------------------------
+ * write out all queued pictures and stop the writer thread
+ */
+static void writer_close(output_writer_t *w)
+{
+    writer_mutex_lock(&w->mutex);
+    w->b_exit = 1;
+    writer_cond_signal(&w->cv_filled);
+    writer_mutex_unlock(&w->mutex);
+
+#if _WIN32
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+#else
+    pthread_join(w->thread, NULL);
+#endif
+
+    writer_cond_destroy(&w->cv_emptied);
+    writer_cond_destroy(&w->cv_filled);
+    writer_mutex_destroy(&w->mutex);
+}
+
+#endif /// DAVS2_WRITER_H